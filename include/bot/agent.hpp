@@ -0,0 +1,61 @@
+#pragma once
+
+#include "engine/igame_engine.hpp"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// How long an agent may think about one piece: a wall-clock budget, or a
+// number of game ticks (converted with the tick length). Microseconds win
+// when both are set.
+struct AgentBudget {
+    int64_t microseconds = 0;
+    int ticks = 0;
+};
+
+class Deadline {
+private:
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+
+public:
+    Deadline(const AgentBudget& budget, float tickDelta);
+
+    bool expired() const { return std::chrono::steady_clock::now() >= end; }
+    // True if work taking `duration` would not finish before the deadline
+    bool expiresWithin(std::chrono::steady_clock::duration duration) const {
+        return std::chrono::steady_clock::now() + duration >= end;
+    }
+    std::chrono::steady_clock::time_point getStart() const { return start; }
+    std::chrono::steady_clock::time_point getEnd() const { return end; }
+    int64_t getBudgetMicroseconds() const;
+};
+
+// Best move sequence found so far. Agents publish every improvement, so a
+// caller that stops waiting at the deadline still gets a usable move.
+class AgentPlan {
+private:
+    mutable std::mutex mutex;
+    std::vector<GameEvent> best;
+    bool ready;
+
+public:
+    AgentPlan();
+
+    void publish(const std::vector<GameEvent>& events);
+    // Move the published plan into events; false if nothing was published
+    bool take(std::vector<GameEvent>& events);
+    void clear();
+};
+
+// A bot that plays through the same events a human would. think() is called
+// once per new piece and must return by the deadline with the full event
+// sequence for that piece (ending in a hard drop) published to the plan.
+class IAgent {
+public:
+    virtual ~IAgent() = default;
+
+    virtual void think(const GameState& state, const Deadline& deadline, AgentPlan& plan) = 0;
+    virtual const char* getName() const = 0;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "agent.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class AgentFactory {
+public:
+    // Create a built-in agent by name; returns nullptr for unknown names
+    static std::unique_ptr<IAgent> create(const std::string& name, uint32_t seed);
+
+    // Names accepted by create()
+    static std::vector<std::string> getNames();
+};
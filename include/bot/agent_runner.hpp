@@ -0,0 +1,67 @@
+#pragma once
+
+#include "agent.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// How an agent used its budgets so far
+struct AgentTimingStats {
+    int decisions = 0;
+    int overruns = 0;       // still thinking when the deadline passed
+    int missed = 0;         // deadline passed with no plan published
+    int64_t usedMicroseconds = 0;
+    int64_t budgetMicroseconds = 0;
+    int64_t maxUsedMicroseconds = 0;
+
+    double getAverageUse() const {
+        return budgetMicroseconds > 0 ? static_cast<double>(usedMicroseconds) / budgetMicroseconds : 0.0;
+    }
+};
+
+// Runs an agent on its own thread so the caller's frame or tick loop never
+// waits on it. request() hands over a state; poll() returns the agent's plan
+// as soon as it finishes, or whatever it has published once the deadline
+// passes.
+class AgentRunner {
+private:
+    IAgent& agent;
+    float tickDelta;
+
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+    bool hasJob;
+    bool busy;
+    std::atomic<bool> finished;
+
+    GameState job;
+    Deadline deadline;
+    AgentPlan plan;
+    bool waiting;
+
+    AgentTimingStats stats;
+
+    void workerLoop();
+
+public:
+    AgentRunner(IAgent& agent, float tickDelta);
+    ~AgentRunner();
+
+    AgentRunner(const AgentRunner&) = delete;
+    AgentRunner& operator=(const AgentRunner&) = delete;
+
+    // Start thinking; false if the agent is still busy with an overrun request
+    bool request(const GameState& state, const AgentBudget& budget);
+
+    // Non-blocking. True once the request is settled; events may be empty
+    // if the agent missed its deadline without publishing anything
+    bool poll(std::vector<GameEvent>& events);
+
+    bool isWaiting() const { return waiting; }
+    AgentTimingStats getStats() const;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "agent.hpp"
+#include "opening_book.hpp"
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Plays book moves while the position is in the opening book and hands
+// every other position to the wrapped agent. The book is shared (read-only)
+// between any number of agents.
+class BookAgent : public IAgent {
+private:
+    std::shared_ptr<const OpeningBook> book;
+    std::unique_ptr<IAgent> fallback;
+    std::vector<GameEvent> events;
+    long long hits;
+
+public:
+    BookAgent(std::shared_ptr<const OpeningBook> book, std::unique_ptr<IAgent> fallback);
+
+    void think(const GameState& state, const Deadline& deadline, AgentPlan& plan) override;
+    const char* getName() const override { return fallback->getName(); }
+
+    // Pieces played straight from the book
+    long long getHits() const { return hits; }
+};
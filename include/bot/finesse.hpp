@@ -0,0 +1,23 @@
+#pragma once
+
+#include "placement.hpp"
+#include <vector>
+
+// Key presses that move a freshly spawned piece to a target placement
+struct FinessePath {
+    // Presses counted the way players count finesse: a tap, holding a
+    // direction into the wall, a rotation, a soft drop to the floor, a
+    // single step down (for spins that need to stop early) and the final
+    // hard drop are one press each
+    int presses;
+    // The same path as engine events (held keys expanded into repeats)
+    std::vector<GameEvent> events;
+};
+
+// Breadth-first search over piece positions, replaying SRS kicks exactly
+// like Game::tryRotate, for the fewest presses that end in the target cells
+class Finesse {
+public:
+    // Path from the spawn position; false if the target can't be reached
+    static bool findPath(const PlacementSearch::Board& board, const Placement& target, FinessePath& out);
+};
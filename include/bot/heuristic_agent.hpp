@@ -0,0 +1,56 @@
+#pragma once
+
+#include "agent.hpp"
+#include "placement.hpp"
+#include <vector>
+
+// Feature weights for scoring a board (defaults tuned for line clearing)
+struct HeuristicWeights {
+    double aggregateHeight = -0.510066;
+    double linesCleared = 0.760666;
+    double holes = -0.35663;
+    double bumpiness = -0.184483;
+};
+
+// Anytime placement search. First scores every drop of the current piece
+// (and of the hold alternative), publishing the best; then, while time
+// remains, refines each candidate with a look-ahead over the next piece.
+// The current piece's drops are always scored in full (the minimum answer);
+// the deadline is checked inside the rest, and a look-ahead is only started
+// if the slowest one so far still fits.
+class HeuristicAgent : public IAgent {
+private:
+    struct Candidate {
+        Placement placement;
+        bool hold;
+        TetrominoType nextType;
+        double score;
+    };
+
+    HeuristicWeights weights;
+    const char* name;
+
+    std::vector<Candidate> candidates;
+    std::vector<Placement> placements;
+    std::vector<Placement> followUps;
+    std::vector<GameEvent> events;
+    PlacementSearch::Board scratch;
+    PlacementSearch::Board lookahead;
+
+    // Placements scored between deadline checks
+    static constexpr int CHECK_INTERVAL = 16;
+
+    // False if the deadline cut scoring short (no deadline: score them all)
+    bool addCandidates(const GameState& state, TetrominoType type, Orientation orientation,
+                       int x, int y, bool hold, TetrominoType nextType, const Deadline* deadline);
+    void publish(const Candidate& candidate, AgentPlan& plan);
+
+public:
+    explicit HeuristicAgent(const HeuristicWeights& weights = HeuristicWeights(),
+                            const char* name = "heuristic");
+
+    void think(const GameState& state, const Deadline& deadline, AgentPlan& plan) override;
+    const char* getName() const override { return name; }
+
+    double score(const BoardFeatures& features) const;
+};
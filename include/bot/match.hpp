@@ -0,0 +1,44 @@
+#pragma once
+
+#include "agent.hpp"
+#include <cstdint>
+
+enum class MatchMode {
+    DUEL,       // Both agents play the same seed on separate boards
+    VERSUS      // Boards linked by garbage, first to top out loses
+};
+
+struct MatchConfig {
+    MatchMode mode = MatchMode::DUEL;
+    uint32_t seed = 0;
+    int maxPieces = 1000;
+    int maxTicks = 60 * 60 * 30;
+    float tickDelta = 1.0f / 60.0f;
+    // Thinking time per piece
+    AgentBudget budget = {1000, 0};
+};
+
+struct PlayerStats {
+    int score;
+    int linesCleared;
+    int piecesLocked;
+    int garbageSent;
+    bool toppedOut;
+    // Average fraction of the per-piece budget the agent used
+    double budgetUsed;
+    // Decisions that returned after their deadline
+    int overruns;
+};
+
+struct MatchResult {
+    PlayerStats players[2];
+    int ticks;
+    // 1 = first agent won, 0.5 = draw, 0 = second agent won
+    double outcome;
+};
+
+class Match {
+public:
+    // Plays one match on the calling thread; games live on its stack
+    static MatchResult play(IAgent& first, IAgent& second, const MatchConfig& config);
+};
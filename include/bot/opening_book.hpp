@@ -0,0 +1,63 @@
+#pragma once
+
+#include "placement.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One precomputed move: press hold first or not, then the placement's
+// rotations and shifts from the spawn position
+struct BookEntry {
+    uint64_t key;
+    uint8_t type;
+    uint8_t orientation;
+    int8_t x;
+    int8_t y;
+    int8_t rotations;
+    int8_t shift;
+    uint8_t hold;
+    uint8_t reserved;
+};
+
+// Read-only opening book: a file of BookEntry records sorted by key,
+// memory-mapped and searched in place with a binary search. Keys hash
+// everything an agent sees when a piece spawns (board occupancy, current
+// piece, hold and preview), so a lookup needs no search at all.
+//
+// File layout: 16-byte header ("TBOOK", version, entry count), then the
+// entries. Build books with tools/book_builder.
+class OpeningBook {
+private:
+    static constexpr uint32_t VERSION = 1;
+
+    void* mapping;
+    std::size_t mappingSize;
+    const BookEntry* entries;
+    std::size_t count;
+
+public:
+    OpeningBook();
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    // Map a book file; false if it is missing or malformed
+    bool open(const std::string& path);
+    void close();
+
+    // The move stored for this position, if any (the piece must be at spawn)
+    bool lookup(const GameState& state, BookEntry& out) const;
+    bool lookup(uint64_t key, BookEntry& out) const;
+
+    std::size_t size() const { return count; }
+
+    static uint64_t hashPosition(const PlacementSearch::Board& board, TetrominoType current,
+                                 TetrominoType hold, bool canHold, TetrominoType next0, TetrominoType next1);
+
+    // Sort, drop duplicate keys and write a book file
+    static bool write(const std::string& path, std::vector<BookEntry>& entries);
+
+    static Placement toPlacement(const BookEntry& entry);
+};
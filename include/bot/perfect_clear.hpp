@@ -0,0 +1,46 @@
+#pragma once
+
+#include "placement.hpp"
+#include <cstdint>
+#include <vector>
+
+struct PerfectClearConfig {
+    // Tallest perfect clear to try (at most 6 rows)
+    int maxHeight = 4;
+    // Most pieces a solution may use
+    int maxPieces = 10;
+    bool allowHold = true;
+    // Worker threads for the root split (0 = one per core)
+    int threads = 0;
+};
+
+// One piece of a solution; the placement is in board coordinates at the
+// moment the piece is placed
+struct PerfectClearStep {
+    Placement placement;
+    // Press hold first (the placed piece comes from hold or the next slot)
+    bool hold;
+};
+
+struct PerfectClearResult {
+    bool found;
+    int height;
+    std::vector<PerfectClearStep> steps;
+    uint64_t nodes;
+};
+
+// Depth-first search for a sequence that empties the board. Boards are
+// packed into 64-bit masks of the bottom rows, failed (board, queue
+// position, hold) states are memoized, and states that can't be completed
+// (an empty region whose size isn't a multiple of 4, more cells to fill
+// than pieces left, or a column-parity imbalance the remaining pieces
+// can't even out) are cut before their placements are generated. The
+// first placements are shared out over worker threads.
+class PerfectClearSolver {
+public:
+    static constexpr int MAX_HEIGHT = 6;
+
+    // queue[0] is the current piece; hold may be TetrominoType::NONE
+    static bool solve(const PlacementSearch::Board& board, const std::vector<TetrominoType>& queue,
+                      TetrominoType hold, const PerfectClearConfig& config, PerfectClearResult& result);
+};
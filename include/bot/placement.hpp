@@ -0,0 +1,47 @@
+#pragma once
+
+#include "engine/igame_engine.hpp"
+#include <vector>
+
+// A final resting spot for a piece and the inputs that reach it: quarter
+// turns from the starting orientation (SRS kicks included), then sideways
+// moves, then a hard drop
+struct Placement {
+    TetrominoType type;
+    Orientation orientation;
+    int x;
+    int y;
+    int rotations;  // 1, 2 = clockwise turns, -1 = one counter-clockwise turn
+    int shift;      // negative = left
+};
+
+// Board features after a placement (lines already removed)
+struct BoardFeatures {
+    int linesCleared;
+    int aggregateHeight;
+    int holes;
+    int bumpiness;
+    int maxHeight;
+};
+
+class PlacementSearch {
+public:
+    static constexpr int BOARD_WIDTH = 10;
+    static constexpr int BOARD_HEIGHT = 20;
+    static constexpr int SPAWN_X = 3;
+    static constexpr int SPAWN_Y = 0;
+
+    using Board = int[BOARD_HEIGHT][BOARD_WIDTH];
+
+    // All drop placements for a piece currently at (x, y) facing orientation
+    static void enumerate(const Board& board, TetrominoType type, Orientation orientation,
+                          int x, int y, std::vector<Placement>& out);
+
+    // Lock the placement into a copy of the board, clear lines and measure it
+    static BoardFeatures evaluate(const Board& board, const Placement& placement, Board& result);
+
+    // Append the inputs that perform the placement
+    static void appendEvents(const Placement& placement, std::vector<GameEvent>& events);
+
+    static bool fits(const Board& board, TetrominoType type, Orientation orientation, int x, int y);
+};
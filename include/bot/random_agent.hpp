@@ -0,0 +1,21 @@
+#pragma once
+
+#include "agent.hpp"
+#include "placement.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Baseline: drops every piece at a uniformly random placement
+class RandomAgent : public IAgent {
+private:
+    std::minstd_rand rng;
+    std::vector<Placement> placements;
+    std::vector<GameEvent> events;
+
+public:
+    explicit RandomAgent(uint32_t seed);
+
+    void think(const GameState& state, const Deadline& deadline, AgentPlan& plan) override;
+    const char* getName() const override { return "random"; }
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "agent.hpp"
+#include "engine/game.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct RolloutConfig {
+    int rollouts = 10000;
+    // Pieces placed in each rollout
+    int maxPieces = 10;
+    // Policy playing the rollouts (an AgentFactory name)
+    std::string policy = "heuristic";
+    // Per-piece thinking; the default is the agent's quickest search
+    AgentBudget budget;
+    // Worker threads (0 = one per core)
+    int threads = 0;
+    uint64_t seed = 1;
+};
+
+struct RolloutResult {
+    int rollouts = 0;
+    double expectedLines = 0.0;
+    // Fraction of rollouts that did not top out within maxPieces
+    double survivalRate = 0.0;
+    double meanScore = 0.0;
+    // Score gained by each rollout, ascending
+    std::vector<int> scores;
+    uint64_t pieces = 0;
+    double seconds = 0.0;
+
+    // Score gained at a quantile (0..1) of the distribution
+    int getScorePercentile(double quantile) const;
+};
+
+// Monte Carlo evaluation of a position. Each rollout copies the Game
+// snapshot (board, current piece, hold and generator), redraws the unseen
+// part of the queue and lets the policy place pieces until it tops out or
+// reaches the horizon. Rollouts advance by placements, not ticks, so
+// gravity never matters. Every thread owns one agent and one Game buffer
+// that is overwritten per rollout, so nothing allocates per rollout.
+// Rollout i always draws the same pieces, so deterministic policies give
+// the same result on any number of threads.
+class RolloutAnalyzer {
+public:
+    // False for an unknown policy
+    static bool analyze(const Game& position, const RolloutConfig& config, RolloutResult& result);
+};
@@ -0,0 +1,120 @@
+#ifndef TETRIS_ENGINE_H
+#define TETRIS_ENGINE_H
+
+/*
+ * C ABI for the Tetris engine (libtetris_engine.so), for loading through FFI
+ * from other runtimes. Games and batches are opaque handles; observations
+ * are written straight into caller-owned buffers with a fixed layout, so a
+ * step never allocates or copies through an intermediate state.
+ *
+ * Stability: functions are only ever added, and tetris_observation only
+ * grows into its reserved bytes. Check tetris_abi_version() at load time.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define TETRIS_API __declspec(dllexport)
+#else
+#define TETRIS_API __attribute__((visibility("default")))
+#endif
+
+#define TETRIS_ABI_VERSION 1
+
+#define TETRIS_BOARD_WIDTH 10
+#define TETRIS_BOARD_HEIGHT 20
+#define TETRIS_PREVIEW_COUNT 5
+
+/* Observation buffers must be aligned to this many bytes */
+#define TETRIS_OBSERVATION_ALIGN 64
+
+/* Largest game count tetris_batch_create accepts (about 55 MB of games) */
+#define TETRIS_MAX_BATCH_SIZE 65536
+
+/* Status codes */
+#define TETRIS_OK 0
+#define TETRIS_ERROR_INVALID (-1)
+#define TETRIS_ERROR_ALIGNMENT (-2)
+
+/* One action per step; NONE just lets time pass */
+enum tetris_action {
+    TETRIS_ACTION_NONE = 0,
+    TETRIS_ACTION_LEFT = 1,
+    TETRIS_ACTION_RIGHT = 2,
+    TETRIS_ACTION_SOFT_DROP = 3,
+    TETRIS_ACTION_ROTATE_CW = 4,
+    TETRIS_ACTION_ROTATE_CCW = 5,
+    TETRIS_ACTION_HARD_DROP = 6,
+    TETRIS_ACTION_HOLD = 7,
+    TETRIS_ACTION_COUNT = 8
+};
+
+/*
+ * Piece codes: 0 empty, 1..7 = I O T S Z J L, 8 garbage.
+ * Orientation: 0 north, 1 east, 2 south, 3 west.
+ * 256 bytes; arrays of observations stay 64-byte aligned element by element.
+ */
+typedef struct tetris_observation {
+    uint8_t board[TETRIS_BOARD_HEIGHT][TETRIS_BOARD_WIDTH]; /* row 0 is the top */
+    uint8_t piece;
+    uint8_t orientation;
+    int8_t piece_x;
+    int8_t piece_y;
+    int8_t ghost_y;
+    uint8_t hold;
+    uint8_t can_hold;
+    uint8_t game_over;
+    uint8_t next[TETRIS_PREVIEW_COUNT];
+    uint8_t last_tspin;         /* 0 none, 1 mini, 2 full */
+    uint8_t back_to_back;
+    uint8_t last_clear_count;
+    int32_t score;
+    int32_t level;
+    int32_t lines_cleared;
+    int32_t pieces_locked;
+    int32_t pending_garbage;
+    int32_t combo;              /* -1 when no clear chain is running */
+    uint8_t reserved[16];
+} tetris_observation;
+
+typedef struct tetris_game tetris_game;
+typedef struct tetris_batch tetris_batch;
+
+TETRIS_API uint32_t tetris_abi_version(void);
+TETRIS_API size_t tetris_observation_size(void);
+
+/* Single games. competitive != 0 selects lock delay and 20G rules. */
+TETRIS_API tetris_game* tetris_game_create(uint32_t seed, int32_t competitive);
+TETRIS_API void tetris_game_destroy(tetris_game* game);
+TETRIS_API int32_t tetris_game_reset(tetris_game* game, uint32_t seed);
+TETRIS_API int32_t tetris_game_observe(const tetris_game* game, tetris_observation* out);
+
+/* Apply the action, run `ticks` ticks of 1/60 s, then write the observation */
+TETRIS_API int32_t tetris_game_step(tetris_game* game, int32_t action, int32_t ticks, tetris_observation* out);
+
+/*
+ * Batches: `count` games in one contiguous arena, game i seeded seed + i.
+ * Stepping takes one action per game and writes count observations into
+ * `out` (count * sizeof(tetris_observation) bytes). `done` (optional,
+ * count bytes) is set for games that ended this step; with auto_reset
+ * they restart at once and `out` shows the new game. Creating returns NULL
+ * for a count outside 1..TETRIS_MAX_BATCH_SIZE or when memory runs out.
+ */
+TETRIS_API tetris_batch* tetris_batch_create(int32_t count, uint32_t seed, int32_t competitive);
+TETRIS_API void tetris_batch_destroy(tetris_batch* batch);
+TETRIS_API int32_t tetris_batch_size(const tetris_batch* batch);
+TETRIS_API int32_t tetris_batch_reset(tetris_batch* batch, uint32_t seed);
+TETRIS_API int32_t tetris_batch_observe(const tetris_batch* batch, tetris_observation* out);
+TETRIS_API int32_t tetris_batch_step(tetris_batch* batch, const int32_t* actions, int32_t ticks,
+                                     tetris_observation* out, uint8_t* done, int32_t auto_reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "igame_engine.hpp"
+
+class AttackTable {
+public:
+    // Garbage lines sent for a normal clear (index = lines cleared)
+    static constexpr int LINE_CLEAR_ATTACK[5] = {0, 0, 1, 2, 4};
+
+    // Garbage lines sent for a T-spin (index = lines cleared)
+    static constexpr int TSPIN_ATTACK[4] = {0, 2, 4, 6};
+    static constexpr int TSPIN_MINI_ATTACK[4] = {0, 0, 1, 2};
+
+    // Extra lines for consecutive clears (index = combo count, capped)
+    static constexpr int COMBO_ATTACK[12] = {0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5};
+
+    // Extra line for chaining difficult clears (tetrises and T-spins)
+    static constexpr int BACK_TO_BACK_BONUS = 1;
+
+    // Extra lines for emptying the whole board
+    static constexpr int PERFECT_CLEAR_BONUS = 10;
+
+    // Get the number of garbage lines a clear sends to the opponent
+    // combo is 0 for the first clear of a chain
+    static int getAttack(int linesCleared, TSpinType tSpin, int combo, bool backToBack,
+                         bool perfectClear = false);
+
+    // Tetrises and T-spins that clear lines keep the back-to-back chain going
+    static bool isDifficultClear(int linesCleared, TSpinType tSpin);
+};
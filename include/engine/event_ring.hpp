@@ -0,0 +1,39 @@
+#pragma once
+
+#include "igame_engine.hpp"
+#include <cstdint>
+
+// Fixed-size log of engine events with independent readers: every reader
+// keeps its own cursor, the oldest events are overwritten first and the
+// ring never allocates, so engines that own one stay trivially copyable.
+template <int Capacity>
+class EventRing {
+private:
+    EngineEvent events[Capacity];
+    uint64_t count = 0;
+
+public:
+    // Slot for the next event (the caller fills it in)
+    EngineEvent& push() {
+        EngineEvent& event = this->events[this->count % Capacity];
+        this->count++;
+        return event;
+    }
+
+    int read(uint64_t& cursor, EngineEvent* out, int capacity) const {
+        // Events older than the ring are gone; skip to the oldest one kept
+        uint64_t oldest = this->count > Capacity ? this->count - Capacity : 0;
+        if (cursor < oldest) {
+            cursor = oldest;
+        }
+
+        int copied = 0;
+        while (cursor < this->count && copied < capacity) {
+            out[copied++] = this->events[cursor % Capacity];
+            cursor++;
+        }
+        return copied;
+    }
+
+    uint64_t getCursor() const { return count; }
+};
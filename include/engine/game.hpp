@@ -1,9 +1,32 @@
 #pragma once
 
 #include "igame_engine.hpp"
+#include "event_ring.hpp"
 #include "tetromino.hpp"
 #include "piece_generator.hpp"
-#include <optional>
+#include <cstdint>
+#include <random>
+
+// Timing rules that differ between casual and competitive play
+struct GameRules {
+    // Time a grounded piece can still move before it locks (0 = lock as
+    // soon as gravity fails to move it)
+    float lockDelay = 0.0f;
+    // Moves or rotations per piece that restart the lock delay
+    int maxLockResets = 15;
+    // Level from which pieces drop to the floor every tick (0 = never)
+    int twentyGLevel = 0;
+    // Piece randomizer (takes effect when the game is reset)
+    RandomizerKind randomizer = RandomizerKind::SEVEN_BAG;
+
+    static GameRules competitive() {
+        GameRules rules;
+        rules.lockDelay = 0.5f;
+        rules.maxLockResets = 15;
+        rules.twentyGLevel = 20;
+        return rules;
+    }
+};
 
 class Game : public IGameEngine {
 private:
@@ -11,13 +34,35 @@ private:
     static constexpr int BOARD_HEIGHT = 20;
     static constexpr int SPAWN_X = 3;
     static constexpr int SPAWN_Y = 0;
+    static constexpr int MAX_GARBAGE_ENTRIES = 16;
+    static constexpr int GARBAGE_CAP_PER_PIECE = 8;
+
+    // A single incoming attack (all of its rows share one hole)
+    struct GarbageEntry {
+        int lines;
+        int holeColumn;
+    };
+
+    // Board state (one byte per cell keeps a Game small enough to pool)
+    uint8_t board[BOARD_HEIGHT][BOARD_WIDTH];
+    uint8_t rowFill[BOARD_HEIGHT];
+    // Highest filled row of each column (BOARD_HEIGHT when empty)
+    uint8_t columnTop[BOARD_WIDTH];
 
-    // Board state
-    int board[BOARD_HEIGHT][BOARD_WIDTH];
+    // Rows touched by the last locked piece (only these can become full)
+    int lockTopRow;
+    int lockBottomRow;
+
+    // Rows removed by the last clear, bottom-up, in pre-clear coordinates
+    int lastClearCount;
+    int lastClearedRows[4];
+
+    // Occupied cells on the board (zero after a clear means a perfect clear)
+    int filledCells;
 
     // Game state
     Tetromino currentPiece;
-    std::optional<Tetromino> heldPiece;
+    TetrominoType heldType;
     bool canHold;
     PieceGenerator generator;
 
@@ -25,20 +70,71 @@ private:
     int score;
     int level;
     int linesCleared;
+    int piecesLocked;
     bool gameOver;
 
     // Timing
+    GameRules rules;
     float dropTimer;
     float dropInterval;
 
+    // Lock delay of the current piece
+    float lockTimer;
+    int lockResets;
+    int lowestY;
+
+    // Versus state
+    GarbageEntry garbageQueue[MAX_GARBAGE_ENTRIES];
+    int garbageHead;
+    int garbageEntries;
+    int pendingGarbage;
+    int outgoingGarbage;
+    int combo;
+    bool backToBack;
+    std::minstd_rand garbageRng;
+
+    // Spin detection: kick used by the last successful rotation, or -1 when
+    // the piece has moved since
+    int lastKickIndex;
+    TSpinType lastTSpin;
+    bool lastPerfectClear;
+
+    // Engine events for readers (about two pieces' worth of inputs)
+    EventRing<32> events;
+
+    // Seed of the current game (piece order and garbage holes follow from it)
+    uint32_t seed;
+
+    // Process metrics are reported only while this points at the game
+    // itself, so copies (rollouts, history replays, search scratch games)
+    // never count as served games, without a hand-written copy constructor
+    const Game* metricsOwner;
+
+    // The C bindings write observations straight from these fields
+    friend class EngineBindings;
+
     // Private game logic methods
     bool isValidPosition(const Tetromino& piece) const;
     bool isValidPosition(const Tetromino& piece, int offsetX, int offsetY) const;
     void lockPiece();
     int clearLines();
+    void clearBoard();
     void spawnNextPiece();
     int calculateGhostY() const;
+    void updateColumnTops();
     void updateDropInterval();
+    bool isTwentyG() const;
+    void dropToFloor();
+    void resetLockState();
+    void onPieceMoved();
+    void extendLockDelay();
+    bool isOccupied(int x, int y) const;
+    TSpinType detectTSpin() const;
+    void finishPiece();
+    int cancelGarbage(int attack);
+    void applyGarbage();
+    void insertGarbageRows(int lines, int holeColumn);
+    EngineEvent& pushEvent(EngineEventType type, int detail = 0, int value = 0);
 
     // Movement helpers (return true if successful)
     bool tryMoveLeft();
@@ -50,12 +146,45 @@ private:
 
 public:
     Game();
+    explicit Game(uint32_t seed, const GameRules& rules = GameRules());
 
     // IGameEngine interface implementation
     void update(float deltaTime) override;
     void handleEvent(GameEvent event) override;
     GameState getState() const override;
+    int readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const override {
+        return events.read(cursor, out, capacity);
+    }
+    uint64_t getEventCursor() const override { return events.getCursor(); }
+
+    // Versus: queue garbage sent by an opponent
+    void receiveGarbage(int lines);
+    // Versus: take the garbage this board has sent since the last call
+    int takeOutgoingGarbage();
+    int getPendingGarbage() const { return pendingGarbage; }
+
+    // Rules apply from the next tick and survive resets
+    void setRules(const GameRules& newRules) { rules = newRules; }
+    const GameRules& getRules() const { return rules; }
+
+    // Cheap checks for headless drivers (no GameState copy)
+    bool isGameOver() const { return gameOver; }
+    int getPiecesLocked() const { return piecesLocked; }
+    // The pieces that will spawn after the current one, in order
+    void peekQueue(TetrominoType* out, int count) const { generator.peek(out, count); }
+    // Redraw the unseen part of the queue (the preview stays), for rollouts
+    void reshuffleQueue(uint64_t seed) { generator.reshuffle(seed); }
+    TSpinType getLastTSpin() const { return lastTSpin; }
+    bool wasPerfectClear() const { return lastPerfectClear; }
+
+    // Report ticks, inputs, pieces, lines and games to Metrics::global().
+    // Off by default; servers and farms turn it on for the games they run.
+    // Enabling counts the current game as started. Copies start disabled.
+    void setMetricsEnabled(bool enabled);
+    bool isMetricsEnabled() const { return metricsOwner == this; }
 
-    // Reset game
+    // Reset game (the next seed is derived from the current one)
     void reset();
+    void reset(uint32_t seed);
+    uint32_t getSeed() const { return seed; }
 };
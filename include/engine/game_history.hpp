@@ -0,0 +1,76 @@
+#pragma once
+
+#include "igame_engine.hpp"
+#include "game.hpp"
+#include <cstddef>
+#include <vector>
+
+struct HistoryConfig {
+    // Ticks between full snapshots (longer = less memory, slower scrubbing)
+    int keyframeInterval = 60;
+    // Memory for snapshots and their input logs; the oldest are overwritten
+    std::size_t memoryBudget = 8 * 1024 * 1024;
+    // Fixed step passed to update() during replay
+    float tickDelta = 1.0f / 60.0f;
+};
+
+// Records a Game as keyframes plus the inputs applied between them, so any
+// tick still inside the ring can be rebuilt by restoring the nearest
+// keyframe and replaying. Forwards everything to the wrapped Game.
+class GameHistory : public IGameEngine {
+private:
+    enum class InputKind {
+        EVENT,
+        GARBAGE
+    };
+
+    struct LoggedInput {
+        int tick;
+        InputKind kind;
+        int value;
+    };
+
+    struct Keyframe {
+        int tick;
+        // Taken mid-tick after a restart, so it only covers later ticks
+        bool afterRestart;
+        Game snapshot;
+        std::vector<LoggedInput> inputs;
+    };
+
+    Game& game;
+    HistoryConfig config;
+
+    // Ring of keyframes, preallocated to fit the memory budget
+    std::vector<Keyframe> keyframes;
+    int oldest;
+    int count;
+    int currentTick;
+
+    void pushKeyframe(bool afterRestart = false);
+    void logInput(InputKind kind, int value);
+    const Keyframe* findKeyframe(int tick) const;
+
+public:
+    explicit GameHistory(Game& game, const HistoryConfig& config = HistoryConfig());
+
+    // IGameEngine interface implementation
+    void update(float deltaTime) override;
+    void handleEvent(GameEvent event) override;
+    GameState getState() const override;
+    int readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const override;
+    uint64_t getEventCursor() const override;
+
+    // Versus input, recorded so replays stay exact
+    void receiveGarbage(int lines);
+
+    // Range of ticks that can still be rebuilt
+    int getOldestTick() const;
+    int getCurrentTick() const { return currentTick; }
+
+    // Rebuild the state right after the given tick
+    GameState getStateAt(int tick) const;
+
+    // Drop all history and start recording from the current game state
+    void clear();
+};
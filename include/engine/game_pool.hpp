@@ -0,0 +1,31 @@
+#pragma once
+
+#include "game.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity arena of games for mass simulation. Every Game is built
+// once, side by side in one allocation, and reset in place when a slot is
+// acquired again, so running many games causes no heap traffic.
+class GamePool {
+private:
+    std::vector<Game> games;
+    // Indices of free slots (used as a stack so recently freed, still cached
+    // games are handed out first)
+    std::vector<uint32_t> freeSlots;
+
+public:
+    explicit GamePool(std::size_t capacity);
+
+    // Reset a free game with the given seed; nullptr when the pool is full
+    Game* acquire(uint32_t seed);
+    // Return a game from this pool so its slot can be reused
+    void release(Game* game);
+
+    std::size_t getCapacity() const { return games.size(); }
+    std::size_t getInUse() const { return games.size() - freeSlots.size(); }
+    std::size_t getSlot(const Game* game) const { return static_cast<std::size_t>(game - games.data()); }
+    Game& operator[](std::size_t slot) { return games[slot]; }
+    const Game& operator[](std::size_t slot) const { return games[slot]; }
+};
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 
-enum class TetrominoType {
+enum class TetrominoType : uint8_t {
     NONE = 0,
     I = 1,
     O = 2,
@@ -10,16 +11,23 @@ enum class TetrominoType {
     S = 4,
     Z = 5,
     J = 6,
-    L = 7
+    L = 7,
+    GARBAGE = 8
 };
 
-enum class Orientation {
+enum class Orientation : uint8_t {
     NORTH = 0,
     EAST = 1,
     SOUTH = 2,
     WEST = 3
 };
 
+enum class TSpinType {
+    NONE,
+    MINI,
+    FULL
+};
+
 enum class GameEvent {
     MOVE_LEFT,
     MOVE_RIGHT,
@@ -31,12 +39,38 @@ enum class GameEvent {
     RESTART
 };
 
+enum class EngineEventType : uint8_t {
+    PIECE_SPAWNED,
+    PIECE_MOVED,
+    PIECE_ROTATED,
+    PIECE_LOCKED,
+    LINES_CLEARED,
+    HOLD_USED,
+    LEVEL_CHANGED,
+    TOP_OUT
+};
+
+// Something that happened inside the engine, recorded as it happened. The
+// piece fields are the current piece at that moment (the piece that locked,
+// the piece that went into hold).
+struct EngineEvent {
+    EngineEventType type;
+    TetrominoType piece;
+    Orientation orientation;
+    int8_t x;
+    int8_t y;
+    // PIECE_ROTATED: SRS kick index; LINES_CLEARED: number of rows
+    int8_t detail;
+    // LINES_CLEARED: bit i set = row (y - i) was cleared, with y the lowest
+    // cleared row in pre-clear coordinates; LEVEL_CHANGED: the new level
+    uint16_t value;
+};
+
 struct GameState {
     // Board state (20 rows x 10 columns)
     int board[20][10];
 
-    // Current piece
-    int currentPieceShape[4][4];
+    // Current piece (its cells come from Tetromino::getShape(type, orientation))
     TetrominoType currentPieceType;
     Orientation currentPieceOrientation;
     int currentPieceX;
@@ -57,7 +91,21 @@ struct GameState {
     int score;
     int level;
     int linesCleared;
+    int piecesLocked;
     bool gameOver;
+
+    // Incoming garbage lines waiting to be inserted
+    int pendingGarbage;
+
+    // Bonuses of the most recently locked piece, and the running chains
+    TSpinType lastTSpin;
+    bool lastPerfectClear;
+    int combo;          // -1 when no clear chain is running
+    bool backToBack;
+
+    // Rows removed by the most recent line clear (bottom-up, pre-clear rows)
+    int lastClearCount;
+    std::array<int, 4> lastClearedRows;
 };
 
 class IGameEngine {
@@ -67,4 +115,17 @@ public:
     virtual void update(float deltaTime) = 0;
     virtual void handleEvent(GameEvent event) = 0;
     virtual GameState getState() const = 0;
+
+    // Events recorded after `cursor`, a position each reader keeps for
+    // itself (start from getEventCursor()). Copies up to `capacity` events,
+    // advances the cursor past them and returns how many were copied; a
+    // reader that falls too far behind skips the events it missed. Engines
+    // that don't record events return 0.
+    virtual int readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const {
+        (void)cursor;
+        (void)out;
+        (void)capacity;
+        return 0;
+    }
+    virtual uint64_t getEventCursor() const { return 0; }
 };
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "igame_engine.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// End-to-end input latency measurement. The front end reports each stage of
+// its loop: a raw key (with the time it was seen), every engine step (after
+// inputs are handed over and after each tick) and every presented frame.
+// The engine applies an input as it is handed over, so an input counts as
+// applied at that step if the step's events show its effect (a shift changes
+// x, a soft drop y), and as displayed at the first frame presented after
+// that; inputs that change nothing (a move into a wall) count as ignored.
+class InputLatencyProbe {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Pending {
+        GameEvent event;
+        Clock::time_point pressed;
+        Clock::time_point applied;
+        uint64_t tick;      // ticks finished when the key arrived
+        bool isApplied;
+    };
+
+    const IGameEngine& engine;
+    uint64_t eventCursor;
+    uint64_t ticks;
+    // Piece position at the last event read
+    int lastX;
+    int lastY;
+    std::vector<Pending> pending;
+
+    // Per-stage samples, in microseconds
+    std::vector<double> toApply;
+    std::vector<double> toDisplay;
+    std::vector<double> total;
+    std::vector<double> ticksToApply;
+    int ignored;
+
+    bool matches(GameEvent event, const EngineEvent& effect) const;
+    void readEvents(Clock::time_point handedBefore, Clock::time_point now);
+    static void printStage(std::FILE* out, const char* name, std::vector<double> samples, const char* unit);
+
+public:
+    explicit InputLatencyProbe(const IGameEngine& engine);
+
+    // A raw key event, before it is handed to the engine
+    void recordKey(GameEvent event, Clock::time_point pressed);
+    // After the queued inputs pressed before `handedBefore` were handed over
+    void recordInputs(Clock::time_point handedBefore, Clock::time_point now);
+    // After a tick ran or the engine changed without input (a reset)
+    void recordStep(Clock::time_point now);
+    void recordTick(Clock::time_point now);
+    // After the frame was presented (EndDrawing)
+    void recordFrame(Clock::time_point now);
+
+    int getSampleCount() const { return static_cast<int>(total.size()); }
+    int getIgnoredCount() const { return ignored; }
+    // Key -> displayed latency at a quantile (0..1), in microseconds
+    double getTotalPercentile(double quantile) const;
+
+    // Percentiles for key -> applied, applied -> displayed and key -> displayed
+    void report(std::FILE* out) const;
+};
+
+// Synthetic key presses for running the measurement headless. A thread
+// presses keys at random (Poisson) times, independent of the frame loop, so
+// the wait until the next input poll is measured as it is for a player.
+class InputInjector {
+public:
+    struct Input {
+        GameEvent event;
+        InputLatencyProbe::Clock::time_point pressed;
+    };
+
+private:
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::vector<Input> queue;
+    std::mt19937 random;
+    double rate;
+
+    void workerLoop();
+
+public:
+    // rate: mean key presses per second
+    InputInjector(double rate, uint32_t seed);
+    ~InputInjector();
+
+    InputInjector(const InputInjector&) = delete;
+    InputInjector& operator=(const InputInjector&) = delete;
+
+    // Everything pressed since the last poll, oldest first
+    void poll(std::vector<Input>& out);
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Operational metrics for long-running engines. Every hot-path update is a
+// single relaxed atomic add on the calling thread's own cache line (threads
+// are spread over a fixed number of shards), and shards are only summed
+// when the metrics are read, so the tick loop never waits on a lock and
+// rarely shares a cache line. Metrics live for the whole process and are read in Prometheus text
+// format (see MetricsExporter).
+namespace Metrics {
+    constexpr int SHARDS = 16;
+
+    inline std::atomic<int> nextShard{0};
+
+    // Shard of the calling thread (fixed at its first update)
+    inline int threadShard() {
+        thread_local int shard = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return shard;
+    }
+
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> value{0};
+    };
+
+    class Counter {
+    private:
+        Cell shards[SHARDS];
+
+    public:
+        void add(uint64_t amount = 1) {
+            this->shards[threadShard()].value.fetch_add(amount, std::memory_order_relaxed);
+        }
+        uint64_t read() const;
+    };
+
+    // A level that goes up and down (queue depths, live games)
+    class Gauge {
+    private:
+        Cell shards[SHARDS];
+
+    public:
+        void add(int64_t amount) {
+            this->shards[threadShard()].value.fetch_add(static_cast<uint64_t>(amount), std::memory_order_relaxed);
+        }
+        void sub(int64_t amount) { this->add(-amount); }
+        int64_t read() const;
+    };
+
+    // Latency distribution over fixed upper bounds (in seconds). An
+    // observation is one add to its bucket and one to the running sum.
+    class Histogram {
+    private:
+        static constexpr int MAX_BUCKETS = 16;
+
+        struct alignas(64) Shard {
+            std::atomic<uint64_t> buckets[MAX_BUCKETS + 1];
+            std::atomic<uint64_t> sumNanoseconds;
+        };
+
+        std::vector<double> bounds;
+        Shard shards[SHARDS];
+
+    public:
+        explicit Histogram(const std::vector<double>& bounds);
+
+        void observe(double seconds) {
+            int bucket = 0;
+            int count = static_cast<int>(this->bounds.size());
+            while (bucket < count && seconds > this->bounds[bucket]) {
+                bucket++;
+            }
+            Shard& shard = this->shards[threadShard()];
+            shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+            shard.sumNanoseconds.fetch_add(static_cast<uint64_t>(seconds * 1e9), std::memory_order_relaxed);
+        }
+
+        const std::vector<double>& getBounds() const { return bounds; }
+        // Per-bucket counts (not cumulative; the last one is +Inf) and the sum
+        void read(std::vector<uint64_t>& counts, double& sumSeconds) const;
+    };
+
+    // Exponential bounds from 1 us to about 1 s, for tick and think times
+    std::vector<double> latencyBounds();
+
+    class Registry {
+    private:
+        enum class Kind {
+            COUNTER,
+            GAUGE,
+            HISTOGRAM
+        };
+
+        struct Entry {
+            std::string name;
+            std::string help;
+            Kind kind;
+            void* metric;
+        };
+
+        mutable std::mutex mutex;
+        std::deque<Counter> counters;
+        std::deque<Gauge> gauges;
+        std::deque<Histogram> histograms;
+        std::vector<Entry> entries;
+
+        void* find(const std::string& name, Kind kind) const;
+
+    public:
+        // Registering a name twice returns the same metric; references stay valid
+        Counter& counter(const std::string& name, const std::string& help);
+        Gauge& gauge(const std::string& name, const std::string& help);
+        Histogram& histogram(const std::string& name, const std::string& help,
+                             const std::vector<double>& bounds = latencyBounds());
+
+        // Prometheus text exposition format (version 0.0.4)
+        std::string writePrometheus() const;
+    };
+
+    // Process-wide registry the engine reports into
+    Registry& global();
+}
@@ -1,23 +1,40 @@
 #pragma once
 
 #include "igame_engine.hpp"
+#include "randomizer.hpp"
 #include "tetromino.hpp"
 #include <array>
-#include <random>
+#include <cstdint>
+#include <variant>
 
 class PieceGenerator {
+public:
+    using Randomizer = std::variant<SevenBagRandomizer, FourteenBagRandomizer, HistoryRandomizer, UniformRandomizer>;
+
 private:
-    std::array<TetrominoType, 7> bag;
-    int bagIndex;
+    Randomizer randomizer;
     std::array<TetrominoType, 2> preview;
-    std::mt19937 rng;
+    Pcg32 rng;
 
-    void refillBag();
-    TetrominoType getNextFromBag();
+    TetrominoType draw();
 
 public:
-    PieceGenerator();
+    explicit PieceGenerator(uint32_t seed, RandomizerKind kind = RandomizerKind::SEVEN_BAG);
 
     Tetromino getNext();
     std::array<TetrominoType, 2> getPreview() const { return preview; }
+
+    // The next count pieces in order, preview first (for analysis tools)
+    void peek(TetrominoType* out, int count) const;
+
+    // A fresh random continuation (for rollouts): keeps the preview and
+    // whatever the randomizer has already committed to (the set of pieces
+    // left in a bag), redraws the rest from the given seed
+    void reshuffle(uint64_t seed);
+
+    static Randomizer makeRandomizer(RandomizerKind kind);
+
+    // "7bag", "14bag", "history" and "random"
+    static const char* getRandomizerName(RandomizerKind kind);
+    static bool parseRandomizer(const char* name, RandomizerKind& kind);
 };
@@ -79,6 +79,8 @@ public:
         {{{0,0}}, {{0,0}}, {{0,0}}, {{0,0}}}
     };
 
+    static constexpr int MAX_KICKS = 5;
+
     // Get wall kick offsets for a rotation
     // Returns vector of (dx, dy) pairs to try
     static std::vector<std::pair<int, int>> getWallKicks(
@@ -87,6 +89,14 @@ public:
         Orientation toOrientation
     );
 
+    // Same offsets without allocating; returns how many were written
+    static int getWallKicks(
+        TetrominoType type,
+        Orientation fromOrientation,
+        Orientation toOrientation,
+        int outKicks[MAX_KICKS][2]
+    );
+
     // Get the next orientation when rotating
     static Orientation getNextOrientation(Orientation current, bool clockwise);
 };
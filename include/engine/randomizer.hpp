@@ -0,0 +1,193 @@
+#pragma once
+
+#include "igame_engine.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+// PCG32 (8 bytes instead of mt19937's 5 KB)
+struct Pcg32 {
+    uint64_t state = 0;
+
+    void seed(uint64_t seed) {
+        this->state = 0;
+        this->next();
+        this->state += seed;
+        this->next();
+    }
+
+    uint32_t next() {
+        uint64_t old = this->state;
+        this->state = old * 6364136223846793005ull + 1442695040888963407ull;
+
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    // Uniform in [0, bound) by multiply-shift
+    uint32_t below(uint32_t bound) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(this->next()) * bound) >> 32);
+    }
+};
+
+enum class RandomizerKind : uint8_t {
+    SEVEN_BAG,
+    FOURTEEN_BAG,
+    HISTORY,
+    RANDOM
+};
+
+// Piece randomizers. Each is a small value type with
+//   TetrominoType next(Pcg32& rng)    the next piece
+//   void reshuffle(Pcg32& rng)        redraw whatever is not yet decided
+// so PieceGenerator can hold any of them in a std::variant (Game stays
+// copyable without heap memory) and analysis code can call one directly
+// in a template loop with everything inlined.
+
+// Shuffled bags holding every piece COPIES times
+template <int COPIES>
+class BagRandomizer {
+private:
+    static constexpr int SIZE = 7 * COPIES;
+
+    std::array<TetrominoType, SIZE> bag;
+    int index = SIZE;
+
+    void refill(Pcg32& rng) {
+        for (int i = 0; i < SIZE; i++) {
+            this->bag[i] = static_cast<TetrominoType>(1 + i % 7);
+        }
+        // Fisher-Yates
+        for (int i = SIZE - 1; i > 0; i--) {
+            std::swap(this->bag[i], this->bag[rng.below(static_cast<uint32_t>(i + 1))]);
+        }
+        this->index = 0;
+    }
+
+public:
+    TetrominoType next(Pcg32& rng) {
+        if (this->index >= SIZE) {
+            this->refill(rng);
+        }
+        return this->bag[this->index++];
+    }
+
+    // Only the unseen rest of the bag is shuffled
+    void reshuffle(Pcg32& rng) {
+        for (int i = SIZE - 1; i > this->index; i--) {
+            uint32_t span = static_cast<uint32_t>(i - this->index + 1);
+            std::swap(this->bag[i], this->bag[this->index + static_cast<int>(rng.below(span))]);
+        }
+    }
+};
+
+using SevenBagRandomizer = BagRandomizer<1>;
+using FourteenBagRandomizer = BagRandomizer<2>;
+
+// Tables over 7-bit piece masks (bit 0 = I ... bit 6 = L), so drawing a
+// piece takes no bit counting: __builtin_popcount is a libgcc call at the
+// default -march
+namespace HistoryTables {
+    constexpr int ROLLS = 6;
+
+    constexpr int countBits(int mask) {
+        int count = 0;
+        for (int bit = 0; bit < 7; bit++) {
+            count += (mask >> bit) & 1;
+        }
+        return count;
+    }
+
+    // Chance (scaled by 2^32) that all ROLLS rolls hit one of the pieces
+    constexpr std::array<uint32_t, 128> buildAllInHistory() {
+        std::array<uint32_t, 128> chances = {};
+        for (int mask = 0; mask < 128; mask++) {
+            uint64_t hits = 1;
+            uint64_t total = 1;
+            for (int roll = 0; roll < ROLLS; roll++) {
+                hits *= static_cast<uint64_t>(countBits(mask));
+                total *= 7;
+            }
+            // Only reachable masks (at most four pieces) are below 2^32
+            chances[mask] = static_cast<uint32_t>(std::min<uint64_t>((hits << 32) / total, UINT32_MAX));
+        }
+        return chances;
+    }
+
+    constexpr std::array<uint8_t, 128> buildCount() {
+        std::array<uint8_t, 128> count = {};
+        for (int mask = 0; mask < 128; mask++) {
+            count[mask] = static_cast<uint8_t>(countBits(mask));
+        }
+        return count;
+    }
+
+    // NTH[mask][k]: the type of the k-th piece in mask
+    constexpr std::array<std::array<uint8_t, 7>, 128> buildNth() {
+        std::array<std::array<uint8_t, 7>, 128> nth = {};
+        for (int mask = 0; mask < 128; mask++) {
+            int k = 0;
+            for (int bit = 0; bit < 7; bit++) {
+                if (mask & (1 << bit)) {
+                    nth[mask][k++] = static_cast<uint8_t>(1 + bit);
+                }
+            }
+        }
+        return nth;
+    }
+
+    inline constexpr std::array<uint32_t, 128> ALL_IN_HISTORY = buildAllInHistory();
+    inline constexpr std::array<uint8_t, 128> COUNT = buildCount();
+    inline constexpr std::array<std::array<uint8_t, 7>, 128> NTH = buildNth();
+
+    static_assert(ALL_IN_HISTORY[0x01] == 36506u, "(1/7)^6");
+    static_assert(NTH[0x5A][2] == 5, "O, S, Z, L");
+}
+
+// TGM-style: reroll up to ROLLS times while the piece is one of the last
+// four; the first piece is never S, Z or O. Rerolling makes every piece
+// outside the history equally likely, and the last roll (uniform over
+// the history) stands only if all ROLLS rolls hit the history, so the
+// outcome is drawn directly: one draw picks the pool, one the piece.
+class HistoryRandomizer {
+private:
+    // The last four pieces as one-hot bytes (bit = type), newest lowest;
+    // starts Z, S, Z, S
+    uint32_t history = 0x10201020u;
+    bool first = true;
+
+public:
+    TetrominoType next(Pcg32& rng) {
+        uint32_t type;
+        if (this->first) {
+            static constexpr TetrominoType OPENERS[4] = {TetrominoType::I, TetrominoType::T, TetrominoType::J,
+                                                         TetrominoType::L};
+            type = static_cast<uint32_t>(OPENERS[rng.below(4)]);
+            this->first = false;
+        } else {
+            uint32_t seen = this->history | (this->history >> 16);
+            seen = ((seen | (seen >> 8)) >> 1) & 0x7Fu;
+
+            uint32_t pool = rng.next() < HistoryTables::ALL_IN_HISTORY[seen] ? seen : (~seen & 0x7Fu);
+            type = HistoryTables::NTH[pool][rng.below(HistoryTables::COUNT[pool])];
+        }
+
+        this->history = (this->history << 8) | (1u << type);
+        return static_cast<TetrominoType>(type);
+    }
+
+    // Nothing is decided ahead of the random stream
+    void reshuffle(Pcg32&) {}
+};
+
+// Independent uniform draws (the memoryless baseline)
+class UniformRandomizer {
+public:
+    TetrominoType next(Pcg32& rng) {
+        return static_cast<TetrominoType>(1 + rng.below(7));
+    }
+
+    void reshuffle(Pcg32&) {}
+};
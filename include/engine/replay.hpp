@@ -0,0 +1,76 @@
+#pragma once
+
+#include "igame_engine.hpp"
+#include "game.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// An input applied at the start of a tick, before that tick's update()
+struct ReplayInput {
+    uint32_t tick;
+    uint8_t event;
+    uint8_t reserved[3];
+};
+
+// A whole game as its seed, rules and tick-stamped inputs. The engine is
+// deterministic (restarts included), so this rebuilds every tick exactly.
+//
+// File layout: 40-byte header ("TRPLY", version, seed, tick rate, rules,
+// tick and input counts), then the inputs in tick order.
+class Replay {
+private:
+    static constexpr uint32_t VERSION = 1;
+
+public:
+    uint32_t seed = 0;
+    GameRules rules;
+    int tickRate = 60;
+    // Length of the recording, so trailing ticks without input still play
+    int ticks = 0;
+    std::vector<ReplayInput> inputs;
+
+    bool save(const std::string& path) const;
+    // False if the file is missing or malformed
+    bool load(const std::string& path);
+};
+
+// Records everything that reaches the wrapped engine into a Replay.
+// Forwards everything, like GameHistory.
+class ReplayRecorder : public IGameEngine {
+private:
+    IGameEngine& engine;
+    Replay replay;
+
+public:
+    // The game supplies the seed and rules the recording starts from
+    ReplayRecorder(IGameEngine& engine, const Game& game, int tickRate);
+
+    // IGameEngine interface implementation
+    void update(float deltaTime) override;
+    void handleEvent(GameEvent event) override;
+    GameState getState() const override;
+    int readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const override;
+    uint64_t getEventCursor() const override;
+
+    const Replay& getReplay() const { return replay; }
+};
+
+// Steps a fresh Game through a Replay one tick at a time
+class ReplayPlayer {
+private:
+    const Replay& replay;
+    Game game;
+    std::size_t nextInput;
+    int tick;
+
+public:
+    explicit ReplayPlayer(const Replay& replay);
+
+    // Apply the tick's inputs and update; false once the recording has ended
+    bool step();
+    bool isFinished() const { return tick >= replay.ticks; }
+
+    int getTick() const { return tick; }
+    const Game& getGame() const { return game; }
+};
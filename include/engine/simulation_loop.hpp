@@ -0,0 +1,70 @@
+#pragma once
+
+#include "igame_engine.hpp"
+#include "input_latency.hpp"
+#include <chrono>
+#include <deque>
+
+// Fixed-rate simulation decoupled from the frame rate (60, 240, 1000 Hz...).
+// Inputs carry the time they happened and are applied just before the tick
+// whose interval contains them, so several inputs within one frame keep
+// their order and spacing relative to gravity and lock delay whatever the
+// display runs at. The frame loop calls advance() with the current time and
+// draws between getPreviousState() and the engine's state by getAlpha().
+class SimulationLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int DEFAULT_TICK_RATE = 60;
+
+private:
+    struct TimedInput {
+        GameEvent event;
+        Clock::time_point time;
+    };
+
+    IGameEngine& engine;
+    int tickRate;
+    float tickDelta;
+    Clock::duration tickDuration;
+
+    // End of the last simulated tick
+    Clock::time_point simulated;
+    bool started;
+
+    // Waiting inputs, oldest first
+    std::deque<TimedInput> inputs;
+
+    // State before the latest tick, for interpolation
+    GameState previous;
+    float alpha;
+
+    InputLatencyProbe* latencyProbe;
+
+    // Applies every queued input stamped before the given time
+    int applyInputs(Clock::time_point before);
+
+public:
+    explicit SimulationLoop(IGameEngine& engine, int tickRate = DEFAULT_TICK_RATE);
+
+    void setTickRate(int ticksPerSecond);
+    int getTickRate() const { return tickRate; }
+    float getTickDelta() const { return tickDelta; }
+
+    // Queue an input that happened at the given time
+    void push(GameEvent event, Clock::time_point time);
+    int getPendingInputs() const { return static_cast<int>(inputs.size()); }
+
+    // Run every tick that ends by `now`, applying inputs in time order, then
+    // the inputs of the tick in progress; returns the number of ticks run
+    int advance(Clock::time_point now);
+
+    // Drop queued inputs and continue from `now` (after a pause)
+    void restart(Clock::time_point now);
+
+    // Fraction of a tick between the last tick and the last advance()
+    float getAlpha() const { return alpha; }
+    const GameState& getPreviousState() const { return previous; }
+
+    // Report applied inputs and ticks to a latency probe
+    void attachLatencyProbe(InputLatencyProbe* probe) { latencyProbe = probe; }
+};
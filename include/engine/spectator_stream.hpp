@@ -0,0 +1,60 @@
+#pragma once
+
+#include "igame_engine.hpp"
+#include "event_ring.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Wire format for watching a game from another process.
+//
+// The stream is a sequence of messages, each prefixed with its length as a
+// varint. A keyframe carries the full packed state (board at 4 bits per
+// cell); a delta starts with a bit mask of the fields that changed since the
+// previous message and carries only those. Ticks where nothing visible
+// changed produce no message at all.
+class SpectatorEncoder {
+private:
+    GameState previous;
+    bool hasPrevious;
+
+public:
+    SpectatorEncoder();
+
+    // Append the changes since the last call (a keyframe on the first call)
+    void encode(const GameState& state, std::vector<uint8_t>& out);
+
+    // Append a full keyframe without touching the delta baseline
+    static void encodeKeyframe(const GameState& state, std::vector<uint8_t>& out);
+
+    // Next encode() starts with a keyframe again
+    void reset() { hasPrevious = false; }
+};
+
+class SpectatorDecoder {
+private:
+    GameState state;
+    bool hasKeyframe;
+    std::vector<uint8_t> pending;
+    EventRing<64> events;
+
+    bool applyMessage(const uint8_t* data, std::size_t size);
+    void recordEvents(const GameState& previous, const GameState& next, bool cleared);
+
+public:
+    SpectatorDecoder();
+
+    // Feed raw stream bytes (any split); returns the number of messages applied
+    // Returns -1 if the stream is corrupt
+    int feed(const uint8_t* data, std::size_t size);
+
+    bool hasState() const { return hasKeyframe; }
+    const GameState& getState() const { return state; }
+
+    // Events rebuilt from the deltas: only what the stream shows (locks and
+    // spawns, line clears, level changes, top-out), not single moves
+    int readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const {
+        return events.read(cursor, out, capacity);
+    }
+    uint64_t getEventCursor() const { return events.getCursor(); }
+};
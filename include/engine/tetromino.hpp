@@ -1,36 +1,125 @@
 #pragma once
 
 #include "igame_engine.hpp"
+#include <array>
+#include <cstdint>
+
+// One orientation of a piece inside its 4x4 box
+struct PieceShape {
+    // Bit (row * 4 + col) is set when that cell is filled
+    uint16_t mask;
+    // Bounding box of the filled cells (inclusive)
+    int8_t minCol, maxCol, minRow, maxRow;
+    // Lowest filled row of each column, -1 for empty columns
+    int8_t columnBottom[4];
+
+    constexpr bool isFilled(int row, int col) const { return (mask >> (row * 4 + col)) & 1; }
+    // Filled cells of one row, bit n = column n
+    constexpr uint16_t getRowBits(int row) const { return (mask >> (row * 4)) & 0xf; }
+};
+
+namespace TetrominoShapes {
+    constexpr int TYPE_COUNT = 9;
+    constexpr int ORIENTATION_COUNT = 4;
+
+    // Base shapes for each tetromino type at each orientation ('#' = filled)
+    constexpr const char* GRIDS[TYPE_COUNT][ORIENTATION_COUNT][4] = {
+        // NONE
+        {{"....", "....", "....", "...."}, {"....", "....", "....", "...."},
+         {"....", "....", "....", "...."}, {"....", "....", "....", "...."}},
+        // I piece (north, east, south, west)
+        {{"....", "####", "....", "...."}, {"..#.", "..#.", "..#.", "..#."},
+         {"....", "....", "####", "...."}, {".#..", ".#..", ".#..", ".#.."}},
+        // O piece
+        {{".##.", ".##.", "....", "...."}, {".##.", ".##.", "....", "...."},
+         {".##.", ".##.", "....", "...."}, {".##.", ".##.", "....", "...."}},
+        // T piece
+        {{".#..", "###.", "....", "...."}, {".#..", ".##.", ".#..", "...."},
+         {"....", "###.", ".#..", "...."}, {".#..", "##..", ".#..", "...."}},
+        // S piece
+        {{".##.", "##..", "....", "...."}, {".#..", ".##.", "..#.", "...."},
+         {"....", ".##.", "##..", "...."}, {"#...", "##..", ".#..", "...."}},
+        // Z piece
+        {{"##..", ".##.", "....", "...."}, {"..#.", ".##.", ".#..", "...."},
+         {"....", "##..", ".##.", "...."}, {".#..", "##..", "#...", "...."}},
+        // J piece
+        {{"#...", "###.", "....", "...."}, {".##.", ".#..", ".#..", "...."},
+         {"....", "###.", "..#.", "...."}, {".#..", ".#..", "##..", "...."}},
+        // L piece
+        {{"..#.", "###.", "....", "...."}, {".#..", ".#..", ".##.", "...."},
+         {"....", "###.", "#...", "...."}, {"##..", ".#..", ".#..", "...."}},
+        // GARBAGE (never a falling piece)
+        {{"....", "....", "....", "...."}, {"....", "....", "....", "...."},
+         {"....", "....", "....", "...."}, {"....", "....", "....", "...."}}
+    };
+
+    constexpr PieceShape buildShape(const char* const grid[4]) {
+        PieceShape shape = {0, 4, -1, 4, -1, {-1, -1, -1, -1}};
+
+        for (int row = 0; row < 4; row++) {
+            for (int col = 0; col < 4; col++) {
+                if (grid[row][col] != '#') continue;
+
+                shape.mask = static_cast<uint16_t>(shape.mask | (1u << (row * 4 + col)));
+                if (col < shape.minCol) shape.minCol = static_cast<int8_t>(col);
+                if (col > shape.maxCol) shape.maxCol = static_cast<int8_t>(col);
+                if (row < shape.minRow) shape.minRow = static_cast<int8_t>(row);
+                if (row > shape.maxRow) shape.maxRow = static_cast<int8_t>(row);
+                shape.columnBottom[col] = static_cast<int8_t>(row);
+            }
+        }
+
+        return shape;
+    }
+
+    constexpr std::array<PieceShape, TYPE_COUNT * ORIENTATION_COUNT> buildTable() {
+        std::array<PieceShape, TYPE_COUNT * ORIENTATION_COUNT> table = {};
+        for (int type = 0; type < TYPE_COUNT; type++) {
+            for (int orientation = 0; orientation < ORIENTATION_COUNT; orientation++) {
+                table[type * ORIENTATION_COUNT + orientation] = buildShape(GRIDS[type][orientation]);
+            }
+        }
+        return table;
+    }
+
+    inline constexpr std::array<PieceShape, TYPE_COUNT * ORIENTATION_COUNT> TABLE = buildTable();
+
+    static_assert(TABLE[3 * ORIENTATION_COUNT].mask == 0x0072, "T north");
+    static_assert(TABLE[1 * ORIENTATION_COUNT + 1].columnBottom[2] == 3, "I east");
+}
 
 class Tetromino {
 private:
     TetrominoType type;
     Orientation orientation;
-    int x, y;
-    int shape[4][4];
-
-    void updateShape();
+    int8_t x, y;
 
 public:
-    Tetromino();
-    Tetromino(TetrominoType type, int startX, int startY);
+    constexpr Tetromino()
+        : type(TetrominoType::NONE), orientation(Orientation::NORTH), x(0), y(0) {}
+    constexpr Tetromino(TetrominoType type, int startX, int startY)
+        : type(type), orientation(Orientation::NORTH),
+          x(static_cast<int8_t>(startX)), y(static_cast<int8_t>(startY)) {}
 
     // Getters
     TetrominoType getType() const { return type; }
     Orientation getOrientation() const { return orientation; }
     int getX() const { return x; }
     int getY() const { return y; }
-    void getShape(int outShape[4][4]) const;
+    const PieceShape& getShape() const { return getShape(type, orientation); }
 
     // Movement
     void moveLeft() { x--; }
     void moveRight() { x++; }
     void moveDown() { y++; }
-    void setPosition(int newX, int newY) { x = newX; y = newY; }
+    void setPosition(int newX, int newY) { x = static_cast<int8_t>(newX); y = static_cast<int8_t>(newY); }
 
     // Rotation
-    void setOrientation(Orientation newOrientation);
+    void setOrientation(Orientation newOrientation) { orientation = newOrientation; }
 
-    // Get base shape for a tetromino type at specific orientation
-    static void getBaseShape(TetrominoType type, Orientation orientation, int outShape[4][4]);
+    // Shape of a tetromino type at a specific orientation
+    static constexpr const PieceShape& getShape(TetrominoType type, Orientation orientation) {
+        return TetrominoShapes::TABLE[static_cast<int>(type) * TetrominoShapes::ORIENTATION_COUNT +
+                                      static_cast<int>(orientation)];
+    }
 };
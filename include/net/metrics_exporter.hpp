@@ -0,0 +1,40 @@
+#pragma once
+#include "engine/metrics.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+
+// Pull-style exporter for a metrics registry. A background thread answers
+// HTTP requests on a loopback port with the Prometheus text format and/or
+// rewrites a file (for node_exporter's textfile collector) at a fixed
+// interval. Reading the metrics never blocks the threads that update them.
+class MetricsExporter {
+private:
+    Metrics::Registry& registry;
+    int listenFd;
+    std::string filePath;
+    float fileInterval;
+    std::thread worker;
+    std::atomic<bool> stopping;
+
+    void workerLoop();
+    void serveClient(int fd);
+
+public:
+    explicit MetricsExporter(Metrics::Registry& registry = Metrics::global());
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Serve GET requests on 127.0.0.1:port (call before start)
+    bool listen(int port);
+    // Rewrite the file every interval seconds, and once more on stop
+    void setFile(const std::string& path, float intervalSeconds = 5.0f);
+
+    void start();
+    void stop();
+
+    // Write the current metrics to a file now (atomically, via rename)
+    bool writeFile(const std::string& path) const;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include "engine/igame_engine.hpp"
+#include "engine/spectator_stream.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Publishes the spectator stream of the wrapped engine after every tick to
+// any number of local subscribers (Unix socket clients, files, pipes).
+// Each encoded chunk is shared by reference between all subscriber queues,
+// so the stream is never copied per subscriber.
+class SpectatorBroadcast : public IGameEngine {
+private:
+    using Chunk = std::shared_ptr<const std::vector<uint8_t>>;
+
+    struct Subscriber {
+        int fd;
+        bool isSocket;
+        std::deque<Chunk> queue;
+        std::size_t offset;
+    };
+
+    // Subscribers that fall this far behind are dropped
+    static constexpr std::size_t MAX_QUEUED_CHUNKS = 1024;
+
+    IGameEngine& source;
+    SpectatorEncoder encoder;
+    std::vector<Subscriber> subscribers;
+
+    int listenFd;
+    std::string socketPath;
+
+    GameState lastState;
+    bool hasState;
+
+    Chunk makeKeyframe() const;
+    void acceptSubscribers();
+    bool flushSubscriber(Subscriber& subscriber);
+
+public:
+    explicit SpectatorBroadcast(IGameEngine& source);
+    ~SpectatorBroadcast();
+
+    SpectatorBroadcast(const SpectatorBroadcast&) = delete;
+    SpectatorBroadcast& operator=(const SpectatorBroadcast&) = delete;
+
+    // IGameEngine interface implementation (publishes after each update)
+    void update(float deltaTime) override;
+    void handleEvent(GameEvent event) override;
+    GameState getState() const override;
+    int readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const override;
+    uint64_t getEventCursor() const override;
+
+    // Accept watchers on a Unix domain socket
+    bool listen(const std::string& path);
+
+    // Stream to an already open descriptor (takes ownership)
+    void addSubscriber(int fd);
+    // Stream to a file (created or truncated)
+    bool addFile(const std::string& path);
+
+    // Encode one tick and send it to all subscribers
+    void publish(const GameState& state);
+
+    std::size_t getSubscriberCount() const { return subscribers.size(); }
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include "engine/igame_engine.hpp"
+#include "engine/spectator_stream.hpp"
+#include <string>
+
+// Read-only engine that rebuilds GameState from a spectator stream, so the
+// renderers can show a game running in another process.
+class SpectatorFeed : public IGameEngine {
+private:
+    int fd;
+    bool isSocket;
+    bool connected;
+    SpectatorDecoder decoder;
+
+public:
+    SpectatorFeed();
+    ~SpectatorFeed();
+
+    SpectatorFeed(const SpectatorFeed&) = delete;
+    SpectatorFeed& operator=(const SpectatorFeed&) = delete;
+
+    // Connect to a broadcast socket, or open a stream file
+    bool open(const std::string& path);
+
+    // IGameEngine interface implementation
+    void update(float deltaTime) override;
+    void handleEvent(GameEvent event) override;
+    GameState getState() const override;
+    int readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const override;
+    uint64_t getEventCursor() const override;
+
+    bool isConnected() const { return connected; }
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include "engine/igame_engine.hpp"
+#include "bot/agent.hpp"
+#include <raylib.h>
+#include <vector>
+
+// Spectator grid for many games at once (bot tournaments, battle royale).
+// Every board is written into one CPU-side texture with one texel per
+// cell, uploaded once per frame and drawn scaled with point filtering, so
+// a frame costs one textured quad however many boards there are. Labels
+// are only drawn when the cells are big enough to read them.
+class GridRenderer {
+private:
+    // Texels per board tile: 10x20 cells plus a one-texel gap
+    static constexpr int TILE_WIDTH = 11;
+    static constexpr int TILE_HEIGHT = 21;
+    static constexpr int HEADER_HEIGHT = 30;
+    static constexpr int LABEL_MIN_CELL = 10;
+    static constexpr float TARGET_TICK_RATE = 1.0f / 60.0f;
+
+    std::vector<IGameEngine*> engines;
+    int screenWidth;
+    int screenHeight;
+
+    // Layout
+    int columns;
+    int rows;
+    int cellSize;
+    int originX;
+    int originY;
+
+    // Cell texture (one texel per cell of every board)
+    std::vector<Color> pixels;
+    Texture2D texture;
+    float tickAccumulator;
+
+    // Bots (optional): one per engine, thinking synchronously once per piece
+    std::vector<IAgent*> agents;
+    AgentBudget agentBudget;
+    int ticksPerPiece;
+    std::vector<int> agentPieces;
+    std::vector<int> agentWait;
+    AgentPlan plan;
+    std::vector<GameEvent> events;
+
+    void computeLayout();
+    void writeBoard(int index, const GameState& state);
+    void drawLabels(const std::vector<GameState>& states);
+    void driveAgents();
+
+public:
+    GridRenderer(const std::vector<IGameEngine*>& engines, int width = 1280, int height = 720);
+    ~GridRenderer();
+
+    GridRenderer(const GridRenderer&) = delete;
+    GridRenderer& operator=(const GridRenderer&) = delete;
+
+    // agents[i] plays engines[i] (nullptr entries are left alone), placing
+    // at most one piece every ticksPerPiece ticks so games stay watchable
+    void attachAgents(const std::vector<IAgent*>& agents, const AgentBudget& budget, int ticksPerPiece);
+
+    // Main loop; R restarts every game
+    void run();
+};
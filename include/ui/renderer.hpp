@@ -1,47 +1,105 @@
 #pragma once
 #include "engine/igame_engine.hpp"
+#include "engine/game_history.hpp"
+#include "engine/input_latency.hpp"
+#include "engine/simulation_loop.hpp"
+#include "bot/agent_runner.hpp"
+#include "ui/screen_layout.hpp"
 #include <raylib.h>
+#include <array>
 #include <map>
+#include <vector>
 
 class Renderer {
 private:
     IGameEngine& gameEngine;
-    int screenWidth;
-    int screenHeight;
-    int cellSize;
-
-    // Layout offsets
-    int boardOffsetX;
-    int boardOffsetY;
-    int holdBoxX;
-    int holdBoxY;
-    int nextBoxX;
-    int nextBoxY;
+
+    // Shared with the offline video export
+    ScreenLayout layout;
 
     // Input mapping (configurable)
     std::map<int, GameEvent> keyMapping;
 
-    // Frame timing for 60 ticks per second
-    static constexpr float TARGET_TICK_RATE = 1.0f / 60.0f;
-    float tickAccumulator;
-    float moveTimer = 0;
+    // Fixed-rate simulation, independent of the frame rate
+    SimulationLoop simulation;
+
+    // Auto-repeat for a held movement key, timed to the exact repeat times
+    int repeatKey = 0;
+    SimulationLoop::Clock::time_point nextRepeat;
+
+    // Line clear flash animation
+    static constexpr float CLEAR_FLASH_TIME = 0.25f;
+    float clearFlashTimer = 0.0f;
+    int clearFlashCount = 0;
+    std::array<int, 4> clearFlashRows = {};
+
+    // Position in the engine's event log
+    uint64_t eventCursor = 0;
+
+    // History scrubbing (only when a GameHistory is attached)
+    GameHistory* history = nullptr;
+    bool scrubbing = false;
+    int scrubTick = 0;
+
+    // Cached text layers: labels, box frames and help text never change;
+    // the stats panel is redrawn only when one of its values changes
+    struct HudValues {
+        int score;
+        int level;
+        int linesCleared;
+        TSpinType lastTSpin;
+        bool lastPerfectClear;
+        bool backToBack;
+        int combo;
+
+        bool operator==(const HudValues& other) const;
+    };
+
+    static constexpr int STATS_LAYER_HEIGHT = 200;
+    RenderTexture2D staticLayer;
+    RenderTexture2D statsLayer;
+    RenderTexture2D gameOverLayer;
+    HudValues hudValues = {};
+    bool hudValid = false;
+
+    // Bot play (only when an AgentRunner is attached)
+    AgentRunner* agentRunner = nullptr;
+    AgentBudget agentBudget;
+    int agentPiece = -1;
+    std::vector<GameEvent> agentEvents;
+
+    // Input latency measurement (only when a probe is attached)
+    InputLatencyProbe* latencyProbe = nullptr;
 
     // Helper rendering methods
     Color getColorForType(TetrominoType type) const;
     void drawCell(int gridX, int gridY, TetrominoType type, float alpha = 1.0f);
-    void drawPieceShape(const int shape[4][4], int offsetX, int offsetY, TetrominoType type, float alpha = 1.0f);
-    void drawTetromino(const GameState& state);
+    void drawPieceShape(const PieceShape& shape, int offsetX, int offsetY, TetrominoType type, float alpha = 1.0f);
+    void drawTetromino(const GameState& state, float pieceX, float pieceY);
     void drawGhostPiece(const GameState& state);
     void drawBoard(const GameState& state);
     void drawCenteredPiece(TetrominoType type, int boxX, int boxY, int boxSize, float alpha);
-    void drawHoldBox(const GameState& state);
-    void drawNextBox(const GameState& state);
+    void drawHoldPiece(const GameState& state);
+    void drawNextPieces(const GameState& state);
+    void drawGarbageMeter(const GameState& state);
+    void processEngineEvents();
+    void updateClearFlash(float frameTime);
+    void drawClearFlash();
+    void buildStaticLayer();
+    void buildGameOverLayer();
+    void updateStatsLayer(const GameState& state);
+    void drawLayer(const RenderTexture2D& layer, int x, int y);
     void drawUI(const GameState& state);
     void drawGameOver();
+    void drawScrubBar();
 
     // Input handling
     void processInput();
+    void pushInput(GameEvent event, SimulationLoop::Clock::time_point time);
     void setupDefaultKeyMapping();
+    void processScrubInput();
+    void driveAgent();
+    void interpolatePiece(const GameState& state, float& pieceX, float& pieceY) const;
 
 public:
     Renderer(IGameEngine& game, int width = 800, int height = 670, int cellSize = 30);
@@ -50,7 +108,20 @@ public:
     // Main game loop
     void run();
 
+    // Simulation ticks per second (60 by default); the board is drawn
+    // between the two latest ticks whatever the display refresh rate
+    void setTickRate(int ticksPerSecond);
+
     // Input configuration
     void mapKey(int raylibKey, GameEvent event);
     void clearKeyMapping();
+
+    // Enable scrub controls: P pauses, [ and ] step a tick, PgUp/PgDn a second
+    void attachHistory(GameHistory* history);
+
+    // Let a bot play; it thinks on its own thread and never blocks a frame
+    void attachAgent(AgentRunner* runner, const AgentBudget& budget);
+
+    // Report every key press, tick and presented frame to a latency probe
+    void attachLatencyProbe(InputLatencyProbe* probe);
 };
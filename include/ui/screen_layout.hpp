@@ -0,0 +1,71 @@
+#pragma once
+
+#include "engine/igame_engine.hpp"
+#include <cstdint>
+
+// Color without raylib, so headless code can share the palette
+struct Rgba {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+// Where everything sits on screen. Both the raylib Renderer and the
+// software FrameRasterizer draw from this, so exported videos look exactly
+// like the window. Header-only: the headless tools don't link ui/.
+struct ScreenLayout {
+    int width;
+    int height;
+    int cellSize;
+
+    int boardX;
+    int boardY;
+    int holdX;
+    int holdY;
+    int nextX;
+    int nextY;
+
+    // Hold and next boxes are 4x4 cells; the next boxes are stacked
+    int boxSize;
+    static constexpr int NEXT_COUNT = 2;
+    static constexpr int NEXT_SPACING = 20;
+
+    // Score panel below the next boxes, controls help near the bottom
+    int statsX;
+    int statsY;
+    int controlsY;
+
+    static constexpr Rgba PANEL = {20, 20, 20, 255};
+    static constexpr Rgba GRID = {50, 50, 50, 255};
+
+    explicit ScreenLayout(int width = 800, int height = 670, int cellSize = 30)
+        : width(width), height(height), cellSize(cellSize) {
+        this->boardX = 250;
+        this->boardY = 50;
+
+        this->holdX = 50;
+        this->holdY = 50;
+
+        this->nextX = this->boardX + (10 * this->cellSize) + 50;
+        this->nextY = 50;
+
+        this->boxSize = 4 * this->cellSize;
+        this->statsX = this->nextX;
+        this->statsY = this->nextY + NEXT_COUNT * (this->boxSize + NEXT_SPACING) + 30;
+        this->controlsY = this->height - 200;
+    }
+
+    static Rgba pieceColor(TetrominoType type) {
+        switch (type) {
+            case TetrominoType::I: return {0, 255, 255, 255};    // Cyan
+            case TetrominoType::O: return {255, 255, 0, 255};    // Yellow
+            case TetrominoType::T: return {128, 0, 128, 255};    // Purple
+            case TetrominoType::S: return {0, 255, 0, 255};      // Green
+            case TetrominoType::Z: return {255, 0, 0, 255};      // Red
+            case TetrominoType::J: return {0, 0, 255, 255};      // Blue
+            case TetrominoType::L: return {255, 165, 0, 255};    // Orange
+            default: return {128, 128, 128, 255};                // Gray
+        }
+    }
+};
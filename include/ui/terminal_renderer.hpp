@@ -0,0 +1,83 @@
+#pragma once
+#include "engine/igame_engine.hpp"
+#include "engine/simulation_loop.hpp"
+#include <map>
+#include <string>
+#include <termios.h>
+
+// Text front end for terminals (SSH, tmux). Keeps the last drawn frame and
+// only writes the cells that changed, in a single write() per frame.
+class TerminalRenderer {
+private:
+    static constexpr int FRAME_WIDTH = 64;
+    static constexpr int FRAME_HEIGHT = 23;
+
+    // Special key codes for escape sequences (plain keys use their byte value)
+    static constexpr int KEY_ARROW_UP = 1000;
+    static constexpr int KEY_ARROW_DOWN = 1001;
+    static constexpr int KEY_ARROW_RIGHT = 1002;
+    static constexpr int KEY_ARROW_LEFT = 1003;
+
+    struct Cell {
+        char ch;
+        unsigned char fg;
+        unsigned char bg;
+
+        bool operator==(const Cell& other) const {
+            return ch == other.ch && fg == other.fg && bg == other.bg;
+        }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    IGameEngine& gameEngine;
+    int framesPerSecond;
+
+    Cell frame[FRAME_HEIGHT][FRAME_WIDTH];
+    Cell lastFrame[FRAME_HEIGHT][FRAME_WIDTH];
+    std::string output;
+
+    termios savedTermios;
+    bool rawMode;
+    bool quitRequested;
+
+    // Input mapping (configurable)
+    std::map<int, GameEvent> keyMapping;
+
+    // Fixed-rate simulation, independent of the frame rate
+    SimulationLoop simulation;
+
+    // Terminal setup
+    void enterRawMode();
+    void leaveRawMode();
+
+    // Helper rendering methods
+    unsigned char getColorForType(TetrominoType type) const;
+    void clearFrame();
+    void putText(int row, int col, const char* text, unsigned char fg);
+    void putCell(int row, int col, TetrominoType type, bool ghost);
+    void drawBoard(const GameState& state);
+    void drawPiece(const GameState& state);
+    void drawPreviewPiece(TetrominoType type, int row, int col);
+    void drawSidebars(const GameState& state);
+    void drawGameOver();
+    void flush();
+    bool writeAll(const std::string& data);
+
+    // Input handling
+    void processInput();
+    void setupDefaultKeyMapping();
+
+public:
+    TerminalRenderer(IGameEngine& game, int framesPerSecond = 30);
+    ~TerminalRenderer();
+
+    // Main game loop (Q or Ctrl-C quits)
+    void run();
+
+    // Simulation ticks per second (60 by default)
+    void setTickRate(int ticksPerSecond);
+
+    // Input configuration
+    void mapKey(int key, GameEvent event);
+    void clearKeyMapping();
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "frame_rasterizer.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Renders frames on worker threads and hands them to a writer thread in
+// order. The producer (usually the thread stepping the game) pushes frame
+// descriptions into a fixed ring of slots whose pixel buffers are
+// allocated once; push() blocks only when every slot is still in flight,
+// which bounds memory and applies back pressure from a slow writer.
+class FramePipeline {
+public:
+    // Called on the writer thread with frames in push order; false stops output
+    using Writer = std::function<bool(const uint8_t* pixels, std::size_t bytes)>;
+
+private:
+    enum class SlotState {
+        FREE,
+        QUEUED,
+        RENDERED
+    };
+
+    struct Slot {
+        FrameInfo frame;
+        std::vector<uint8_t> pixels;
+        SlotState state = SlotState::FREE;
+    };
+
+    const FrameRasterizer& rasterizer;
+    Writer writer;
+    std::vector<Slot> slots;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    uint64_t pushed = 0;
+    uint64_t nextToRender = 0;
+    uint64_t nextToWrite = 0;
+    bool closing = false;
+    bool failed = false;
+
+    std::vector<std::thread> workers;
+    std::thread writerThread;
+
+    void renderLoop();
+    void writeLoop();
+
+public:
+    // threads <= 0 uses one render thread per core
+    FramePipeline(const FrameRasterizer& rasterizer, int threads, Writer writer);
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Queue the next frame; false once the writer has failed
+    bool push(const FrameInfo& frame);
+
+    // Wait until every pushed frame is written; false if the writer failed
+    bool finish();
+
+    uint64_t getFramesWritten();
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "engine/igame_engine.hpp"
+#include "ui/screen_layout.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Everything one frame shows: the game state plus the Renderer's effects
+struct FrameInfo {
+    GameState state;
+    // Line clear flash, 1 when it starts and fading to 0
+    float clearFlash = 0.0f;
+    int clearFlashCount = 0;
+    std::array<int, 4> clearFlashRows = {};
+};
+
+// Software version of Renderer's drawing, into an RGBA8 framebuffer in
+// memory: no window, no GPU. Labels, boxes and help text are rasterized
+// once into a background that every frame starts from; text uses a
+// built-in 5x7 bitmap font scaled to the Renderer's font sizes.
+// render() only reads the rasterizer, so threads can share one.
+class FrameRasterizer {
+private:
+    ScreenLayout layout;
+    std::vector<uint8_t> background;
+
+    void fillRect(uint8_t* pixels, int x, int y, int width, int height, Rgba color) const;
+    void strokeRect(uint8_t* pixels, int x, int y, int width, int height, Rgba color) const;
+    void drawText(uint8_t* pixels, const char* text, int x, int y, int fontSize, Rgba color) const;
+    static int measureText(const char* text, int fontSize);
+
+    void drawCell(uint8_t* pixels, int x, int y, TetrominoType type, float alpha) const;
+    void drawPieceShape(uint8_t* pixels, TetrominoType type, Orientation orientation,
+                        int offsetX, int offsetY, float alpha) const;
+    void drawCenteredPiece(uint8_t* pixels, TetrominoType type, int boxX, int boxY, float alpha) const;
+    void drawBoard(uint8_t* pixels, const GameState& state) const;
+    void drawStats(uint8_t* pixels, const GameState& state) const;
+    void drawGameOver(uint8_t* pixels) const;
+    void buildBackground();
+
+public:
+    explicit FrameRasterizer(const ScreenLayout& layout = ScreenLayout());
+
+    int getWidth() const { return layout.width; }
+    int getHeight() const { return layout.height; }
+    std::size_t getFrameBytes() const { return background.size(); }
+
+    // Draw a frame into getFrameBytes() bytes of RGBA
+    void render(const FrameInfo& frame, uint8_t* pixels) const;
+};
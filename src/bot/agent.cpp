@@ -0,0 +1,42 @@
+#include "bot/agent.hpp"
+
+Deadline::Deadline(const AgentBudget& budget, float tickDelta)
+    : start(std::chrono::steady_clock::now()) {
+    int64_t microseconds = budget.microseconds;
+    if (microseconds <= 0) {
+        microseconds = static_cast<int64_t>(budget.ticks * tickDelta * 1e6f);
+    }
+
+    this->end = this->start + std::chrono::microseconds(microseconds);
+}
+
+int64_t Deadline::getBudgetMicroseconds() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(this->end - this->start).count();
+}
+
+AgentPlan::AgentPlan() : ready(false) {
+    this->best.reserve(16);
+}
+
+void AgentPlan::publish(const std::vector<GameEvent>& events) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->best.assign(events.begin(), events.end());
+    this->ready = true;
+}
+
+bool AgentPlan::take(std::vector<GameEvent>& events) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->ready) {
+        return false;
+    }
+
+    events.assign(this->best.begin(), this->best.end());
+    this->ready = false;
+    return true;
+}
+
+void AgentPlan::clear() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->best.clear();
+    this->ready = false;
+}
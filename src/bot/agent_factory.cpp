@@ -0,0 +1,27 @@
+#include "bot/agent_factory.hpp"
+#include "bot/heuristic_agent.hpp"
+#include "bot/random_agent.hpp"
+
+std::unique_ptr<IAgent> AgentFactory::create(const std::string& name, uint32_t seed) {
+    if (name == "heuristic") {
+        return std::make_unique<HeuristicAgent>();
+    }
+
+    if (name == "stacker") {
+        // Ignores surface shape: keeps the stack low but leaves it ragged
+        HeuristicWeights weights;
+        weights.bumpiness = 0.0;
+        weights.holes = -0.2;
+        return std::make_unique<HeuristicAgent>(weights, "stacker");
+    }
+
+    if (name == "random") {
+        return std::make_unique<RandomAgent>(seed);
+    }
+
+    return nullptr;
+}
+
+std::vector<std::string> AgentFactory::getNames() {
+    return {"heuristic", "stacker", "random"};
+}
@@ -0,0 +1,95 @@
+#include "bot/agent_runner.hpp"
+#include <algorithm>
+
+AgentRunner::AgentRunner(IAgent& agent, float tickDelta)
+    : agent(agent), tickDelta(tickDelta), stopping(false), hasJob(false), busy(false),
+      finished(false), deadline(AgentBudget(), tickDelta), waiting(false) {
+    this->worker = std::thread(&AgentRunner::workerLoop, this);
+}
+
+AgentRunner::~AgentRunner() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->wake.notify_one();
+    this->worker.join();
+}
+
+bool AgentRunner::request(const GameState& state, const AgentBudget& budget) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->busy || this->hasJob) {
+            return false;
+        }
+
+        this->job = state;
+        this->deadline = Deadline(budget, this->tickDelta);
+        this->plan.clear();
+        this->finished.store(false, std::memory_order_relaxed);
+        this->hasJob = true;
+        this->waiting = true;
+    }
+
+    this->wake.notify_one();
+    return true;
+}
+
+bool AgentRunner::poll(std::vector<GameEvent>& events) {
+    events.clear();
+    if (!this->waiting) {
+        return false;
+    }
+
+    bool done = this->finished.load(std::memory_order_acquire);
+    if (!done && !this->deadline.expired()) {
+        return false;
+    }
+
+    bool published = this->plan.take(events);
+    this->waiting = false;
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!done) {
+        this->stats.overruns++;
+    }
+    if (!published) {
+        this->stats.missed++;
+    }
+    return true;
+}
+
+AgentTimingStats AgentRunner::getStats() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stats;
+}
+
+void AgentRunner::workerLoop() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (true) {
+        this->wake.wait(lock, [this]() { return this->stopping || this->hasJob; });
+        if (this->stopping) {
+            return;
+        }
+
+        this->hasJob = false;
+        this->busy = true;
+        GameState state = this->job;
+        Deadline current = this->deadline;
+        lock.unlock();
+
+        this->agent.think(state, current, this->plan);
+        auto finishedAt = std::chrono::steady_clock::now();
+
+        lock.lock();
+        int64_t used = std::chrono::duration_cast<std::chrono::microseconds>(
+            finishedAt - current.getStart()).count();
+        this->stats.decisions++;
+        this->stats.usedMicroseconds += used;
+        this->stats.budgetMicroseconds += current.getBudgetMicroseconds();
+        this->stats.maxUsedMicroseconds = std::max(this->stats.maxUsedMicroseconds, used);
+        this->busy = false;
+        this->finished.store(true, std::memory_order_release);
+    }
+}
@@ -0,0 +1,22 @@
+#include "bot/book_agent.hpp"
+
+BookAgent::BookAgent(std::shared_ptr<const OpeningBook> book, std::unique_ptr<IAgent> fallback)
+    : book(std::move(book)), fallback(std::move(fallback)), hits(0) {
+    this->events.reserve(16);
+}
+
+void BookAgent::think(const GameState& state, const Deadline& deadline, AgentPlan& plan) {
+    BookEntry entry;
+    if (!this->book->lookup(state, entry)) {
+        this->fallback->think(state, deadline, plan);
+        return;
+    }
+
+    this->events.clear();
+    if (entry.hold) {
+        this->events.push_back(GameEvent::HOLD);
+    }
+    PlacementSearch::appendEvents(OpeningBook::toPlacement(entry), this->events);
+    plan.publish(this->events);
+    this->hits++;
+}
@@ -0,0 +1,209 @@
+#include "bot/finesse.hpp"
+#include "engine/piece_rotation.hpp"
+#include "engine/tetromino.hpp"
+#include <cstdint>
+
+namespace {
+    constexpr int MIN_X = -3;
+    constexpr int MIN_Y = -3;
+    constexpr int X_RANGE = PlacementSearch::BOARD_WIDTH - MIN_X;
+    constexpr int Y_RANGE = PlacementSearch::BOARD_HEIGHT - MIN_Y;
+    constexpr int STATE_COUNT = 4 * X_RANGE * Y_RANGE;
+
+    enum Action : uint8_t {
+        TAP_LEFT,
+        TAP_RIGHT,
+        DAS_LEFT,
+        DAS_RIGHT,
+        ROTATE_CW,
+        ROTATE_CCW,
+        SOFT_DROP,
+        STEP_DOWN,
+        ACTION_COUNT
+    };
+
+    struct Position {
+        int orientation;
+        int x;
+        int y;
+    };
+
+    struct Node {
+        int parent;
+        Action action;
+        int distance;
+    };
+
+    int stateIndex(const Position& p) {
+        return (p.orientation * X_RANGE + (p.x - MIN_X)) * Y_RANGE + (p.y - MIN_Y);
+    }
+
+    Position statePosition(int index) {
+        Position p;
+        p.y = index % Y_RANGE + MIN_Y;
+        index /= Y_RANGE;
+        p.x = index % X_RANGE + MIN_X;
+        p.orientation = index / X_RANGE;
+        return p;
+    }
+
+    // The four occupied board cells, packed in row-major order
+    uint32_t cellKey(TetrominoType type, int orientation, int x, int y) {
+        const PieceShape& shape = Tetromino::getShape(type, static_cast<Orientation>(orientation));
+        uint32_t key = 0;
+        int shift = 0;
+        for (int row = shape.minRow; row <= shape.maxRow; row++) {
+            for (int col = shape.minCol; col <= shape.maxCol; col++) {
+                if (shape.isFilled(row, col)) {
+                    key |= static_cast<uint32_t>((y + row) * PlacementSearch::BOARD_WIDTH + (x + col)) << shift;
+                    shift += 8;
+                }
+            }
+        }
+        return key;
+    }
+
+    bool fits(const PlacementSearch::Board& board, TetrominoType type, const Position& p) {
+        return p.x >= MIN_X && p.x < PlacementSearch::BOARD_WIDTH && p.y >= MIN_Y &&
+               p.y < PlacementSearch::BOARD_HEIGHT &&
+               PlacementSearch::fits(board, type, static_cast<Orientation>(p.orientation), p.x, p.y);
+    }
+
+    // Apply an action; returns false if the piece doesn't move
+    bool apply(const PlacementSearch::Board& board, TetrominoType type, Position p, Action action,
+               Position& out, int& repeats) {
+        repeats = 0;
+
+        switch (action) {
+            case TAP_LEFT:
+            case TAP_RIGHT:
+            case DAS_LEFT:
+            case DAS_RIGHT: {
+                int direction = (action == TAP_LEFT || action == DAS_LEFT) ? -1 : 1;
+                bool held = action == DAS_LEFT || action == DAS_RIGHT;
+                Position next = {p.orientation, p.x + direction, p.y};
+                while (fits(board, type, next)) {
+                    p = next;
+                    repeats++;
+                    if (!held) break;
+                    next.x += direction;
+                }
+                break;
+            }
+            case SOFT_DROP:
+            case STEP_DOWN: {
+                Position next = {p.orientation, p.x, p.y + 1};
+                while (fits(board, type, next)) {
+                    p = next;
+                    repeats++;
+                    if (action == STEP_DOWN) break;
+                    next.y++;
+                }
+                break;
+            }
+            case ROTATE_CW:
+            case ROTATE_CCW: {
+                Orientation from = static_cast<Orientation>(p.orientation);
+                Orientation to = PieceRotation::getNextOrientation(from, action == ROTATE_CW);
+                int kicks[PieceRotation::MAX_KICKS][2];
+                int count = PieceRotation::getWallKicks(type, from, to, kicks);
+
+                for (int i = 0; i < count; i++) {
+                    Position next = {static_cast<int>(to), p.x + kicks[i][0], p.y + kicks[i][1]};
+                    if (fits(board, type, next)) {
+                        p = next;
+                        repeats = 1;
+                        break;
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        out = p;
+        return repeats > 0;
+    }
+
+    void appendAction(Action action, int repeats, std::vector<GameEvent>& events) {
+        static const GameEvent EVENTS[ACTION_COUNT] = {
+            GameEvent::MOVE_LEFT, GameEvent::MOVE_RIGHT, GameEvent::MOVE_LEFT, GameEvent::MOVE_RIGHT,
+            GameEvent::ROTATE_CW, GameEvent::ROTATE_CCW, GameEvent::MOVE_DOWN, GameEvent::MOVE_DOWN
+        };
+        for (int i = 0; i < repeats; i++) {
+            events.push_back(EVENTS[action]);
+        }
+    }
+}
+
+bool Finesse::findPath(const PlacementSearch::Board& board, const Placement& target, FinessePath& out) {
+    out.presses = 0;
+    out.events.clear();
+
+    TetrominoType type = target.type;
+    uint32_t targetKey = cellKey(type, static_cast<int>(target.orientation), target.x, target.y);
+
+    Position spawn = {static_cast<int>(Orientation::NORTH), PlacementSearch::SPAWN_X, PlacementSearch::SPAWN_Y};
+    if (!fits(board, type, spawn)) {
+        return false;
+    }
+
+    Node nodes[STATE_COUNT];
+    bool seen[STATE_COUNT] = {};
+    int queue[STATE_COUNT];
+    int head = 0;
+    int tail = 0;
+
+    int start = stateIndex(spawn);
+    seen[start] = true;
+    nodes[start] = {-1, ACTION_COUNT, 0};
+    queue[tail++] = start;
+
+    while (head < tail) {
+        int index = queue[head++];
+        Position p = statePosition(index);
+
+        // Would a hard drop from here land on the target?
+        Position landing = p;
+        while (fits(board, type, {landing.orientation, landing.x, landing.y + 1})) {
+            landing.y++;
+        }
+
+        if (cellKey(type, landing.orientation, landing.x, landing.y) == targetKey) {
+            out.presses = nodes[index].distance + 1;
+
+            // Walk back to the spawn, then replay forwards
+            Action path[STATE_COUNT];
+            int length = 0;
+            for (int i = index; nodes[i].parent >= 0; i = nodes[i].parent) {
+                path[length++] = nodes[i].action;
+            }
+
+            Position current = spawn;
+            for (int i = length - 1; i >= 0; i--) {
+                int repeats;
+                apply(board, type, current, path[i], current, repeats);
+                appendAction(path[i], repeats, out.events);
+            }
+            out.events.push_back(GameEvent::HARD_DROP);
+            return true;
+        }
+
+        for (int a = 0; a < ACTION_COUNT; a++) {
+            Action action = static_cast<Action>(a);
+            Position next;
+            int repeats;
+            if (!apply(board, type, p, action, next, repeats)) continue;
+
+            int nextIndex = stateIndex(next);
+            if (seen[nextIndex]) continue;
+
+            seen[nextIndex] = true;
+            nodes[nextIndex] = {index, action, nodes[index].distance + 1};
+            queue[tail++] = nextIndex;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,114 @@
+#include "bot/heuristic_agent.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+HeuristicAgent::HeuristicAgent(const HeuristicWeights& weights, const char* name)
+    : weights(weights), name(name) {
+    this->candidates.reserve(128);
+    this->placements.reserve(64);
+    this->followUps.reserve(64);
+    this->events.reserve(16);
+}
+
+double HeuristicAgent::score(const BoardFeatures& features) const {
+    return this->weights.aggregateHeight * features.aggregateHeight +
+           this->weights.linesCleared * features.linesCleared +
+           this->weights.holes * features.holes +
+           this->weights.bumpiness * features.bumpiness;
+}
+
+bool HeuristicAgent::addCandidates(const GameState& state, TetrominoType type, Orientation orientation,
+                                   int x, int y, bool hold, TetrominoType nextType, const Deadline* deadline) {
+    PlacementSearch::enumerate(state.board, type, orientation, x, y, this->placements);
+
+    for (std::size_t i = 0; i < this->placements.size(); i++) {
+        if (deadline != nullptr && i % CHECK_INTERVAL == CHECK_INTERVAL - 1 && deadline->expired()) {
+            return false;
+        }
+        const Placement& placement = this->placements[i];
+        double value = this->score(PlacementSearch::evaluate(state.board, placement, this->scratch));
+        this->candidates.push_back({placement, hold, nextType, value});
+    }
+    return true;
+}
+
+void HeuristicAgent::publish(const Candidate& candidate, AgentPlan& plan) {
+    this->events.clear();
+    if (candidate.hold) {
+        this->events.push_back(GameEvent::HOLD);
+    }
+    PlacementSearch::appendEvents(candidate.placement, this->events);
+    plan.publish(this->events);
+}
+
+void HeuristicAgent::think(const GameState& state, const Deadline& deadline, AgentPlan& plan) {
+    this->candidates.clear();
+    if (state.gameOver) {
+        return;
+    }
+
+    // Depth 1: current piece where it is, always scored in full (think()
+    // must publish a move, and this is the cheapest complete one), then the
+    // piece a hold would bring in if there is time
+    this->addCandidates(state, state.currentPieceType, state.currentPieceOrientation, state.currentPieceX,
+                        state.currentPieceY, false, state.nextPieces[0], nullptr);
+    bool complete = !deadline.expired();
+
+    if (complete && state.canHold) {
+        TetrominoType swapped = state.hasHeldPiece ? state.heldPieceType : state.nextPieces[0];
+        TetrominoType next = state.hasHeldPiece ? state.nextPieces[0] : state.nextPieces[1];
+
+        if (swapped != TetrominoType::NONE && swapped != state.currentPieceType) {
+            complete = this->addCandidates(state, swapped, Orientation::NORTH, PlacementSearch::SPAWN_X,
+                                           PlacementSearch::SPAWN_Y, true, next, &deadline);
+        }
+    }
+
+    if (this->candidates.empty()) {
+        return;
+    }
+
+    std::sort(this->candidates.begin(), this->candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+    this->publish(this->candidates.front(), plan);
+    if (!complete) {
+        return;
+    }
+
+    // Depth 2, best candidates first, while the slowest look-ahead so far
+    // still fits before the deadline
+    double bestScore = -std::numeric_limits<double>::infinity();
+    std::chrono::steady_clock::duration slowest(0);
+
+    for (const Candidate& candidate : this->candidates) {
+        if (deadline.expiresWithin(slowest)) {
+            return;
+        }
+        if (candidate.nextType == TetrominoType::NONE) {
+            continue;
+        }
+        auto started = std::chrono::steady_clock::now();
+
+        BoardFeatures first = PlacementSearch::evaluate(state.board, candidate.placement, this->scratch);
+        PlacementSearch::enumerate(this->scratch, candidate.nextType, Orientation::NORTH,
+                                   PlacementSearch::SPAWN_X, PlacementSearch::SPAWN_Y, this->followUps);
+
+        // Lines cleared by either piece count towards the pair
+        double best = -std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < this->followUps.size(); i++) {
+            if (i % CHECK_INTERVAL == CHECK_INTERVAL - 1 && deadline.expired()) {
+                return;
+            }
+            BoardFeatures second = PlacementSearch::evaluate(this->scratch, this->followUps[i], this->lookahead);
+            second.linesCleared += first.linesCleared;
+            best = std::max(best, this->score(second));
+        }
+
+        if (best > bestScore) {
+            bestScore = best;
+            this->publish(candidate, plan);
+        }
+        slowest = std::max(slowest, std::chrono::steady_clock::now() - started);
+    }
+}
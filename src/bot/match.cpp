@@ -0,0 +1,113 @@
+#include "bot/match.hpp"
+#include "engine/game.hpp"
+#include <chrono>
+#include <vector>
+
+namespace {
+    struct Player {
+        Game game;
+        IAgent* agent;
+        AgentPlan plan;
+        int plannedPiece = -1;
+        int garbageSent = 0;
+        int decisions = 0;
+        int overruns = 0;
+        double budgetUsed = 0.0;
+
+        Player(uint32_t seed, IAgent* agent) : game(seed), agent(agent) {}
+    };
+
+    // Ask the agent once per piece and apply its plan in the same tick
+    void stepAgent(Player& player, const MatchConfig& config, std::vector<GameEvent>& events) {
+        if (player.game.getPiecesLocked() == player.plannedPiece) {
+            return;
+        }
+        player.plannedPiece = player.game.getPiecesLocked();
+
+        Deadline deadline(config.budget, config.tickDelta);
+        player.plan.clear();
+        player.agent->think(player.game.getState(), deadline, player.plan);
+
+        auto used = std::chrono::steady_clock::now() - deadline.getStart();
+        auto budget = deadline.getEnd() - deadline.getStart();
+        player.decisions++;
+        player.budgetUsed += budget.count() > 0 ? static_cast<double>(used.count()) / budget.count() : 0.0;
+        if (deadline.expired()) {
+            player.overruns++;
+        }
+
+        if (player.plan.take(events)) {
+            for (GameEvent event : events) {
+                player.game.handleEvent(event);
+            }
+        }
+    }
+
+    PlayerStats collectStats(const Player& player) {
+        GameState state = player.game.getState();
+        double budgetUsed = player.decisions > 0 ? player.budgetUsed / player.decisions : 0.0;
+        return {state.score, state.linesCleared, state.piecesLocked, player.garbageSent,
+                state.gameOver, budgetUsed, player.overruns};
+    }
+
+    double compare(const PlayerStats& first, const PlayerStats& second) {
+        if (first.toppedOut != second.toppedOut) {
+            return first.toppedOut ? 0.0 : 1.0;
+        }
+        if (first.score != second.score) {
+            return first.score > second.score ? 1.0 : 0.0;
+        }
+        return 0.5;
+    }
+
+    bool finished(const Game& game, const MatchConfig& config) {
+        return game.isGameOver() || game.getPiecesLocked() >= config.maxPieces;
+    }
+}
+
+MatchResult Match::play(IAgent& first, IAgent& second, const MatchConfig& config) {
+    Player players[2] = {Player(config.seed, &first), Player(config.seed, &second)};
+
+    std::vector<GameEvent> events;
+    events.reserve(16);
+
+    MatchResult result;
+    result.ticks = 0;
+
+    if (config.mode == MatchMode::DUEL) {
+        // Independent boards with identical piece sequences
+        for (int p = 0; p < 2; p++) {
+            int ticks = 0;
+            while (!finished(players[p].game, config) && ticks < config.maxTicks) {
+                stepAgent(players[p], config, events);
+                players[p].game.update(config.tickDelta);
+                ticks++;
+            }
+            result.ticks = ticks > result.ticks ? ticks : result.ticks;
+        }
+    } else {
+        while (result.ticks < config.maxTicks &&
+               !finished(players[0].game, config) && !finished(players[1].game, config)) {
+            for (Player& player : players) {
+                stepAgent(player, config, events);
+                player.game.update(config.tickDelta);
+            }
+
+            // Exchange attacks after both boards moved so neither side goes first
+            int sent0 = players[0].game.takeOutgoingGarbage();
+            int sent1 = players[1].game.takeOutgoingGarbage();
+            players[1].game.receiveGarbage(sent0);
+            players[0].game.receiveGarbage(sent1);
+            players[0].garbageSent += sent0;
+            players[1].garbageSent += sent1;
+
+            result.ticks++;
+        }
+    }
+
+    result.players[0] = collectStats(players[0]);
+    result.players[1] = collectStats(players[1]);
+    result.outcome = compare(result.players[0], result.players[1]);
+
+    return result;
+}
@@ -0,0 +1,166 @@
+#include "bot/opening_book.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const char MAGIC[6] = {'T', 'B', 'O', 'O', 'K', '\0'};
+
+    struct BookHeader {
+        char magic[6];
+        uint16_t version;
+        uint64_t count;
+    };
+
+    static_assert(sizeof(BookHeader) == 16, "book header must stay 16 bytes");
+    static_assert(sizeof(BookEntry) == 16, "book entries must stay 16 bytes");
+
+    uint64_t mix(uint64_t hash, uint64_t value) {
+        // hash_combine step, then the splitmix64 finalizer
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ull;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebull;
+        hash ^= hash >> 31;
+        return hash;
+    }
+}
+
+OpeningBook::OpeningBook() : mapping(nullptr), mappingSize(0), entries(nullptr), count(0) {}
+
+OpeningBook::~OpeningBook() {
+    this->close();
+}
+
+bool OpeningBook::open(const std::string& path) {
+    this->close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(BookHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    BookHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.count != (size - sizeof(BookHeader)) / sizeof(BookEntry)) {
+        munmap(mapped, size);
+        return false;
+    }
+
+    this->mapping = mapped;
+    this->mappingSize = size;
+    this->entries = reinterpret_cast<const BookEntry*>(static_cast<const char*>(mapped) + sizeof(BookHeader));
+    this->count = static_cast<std::size_t>(header.count);
+    return true;
+}
+
+void OpeningBook::close() {
+    if (this->mapping != nullptr) {
+        munmap(this->mapping, this->mappingSize);
+    }
+    this->mapping = nullptr;
+    this->mappingSize = 0;
+    this->entries = nullptr;
+    this->count = 0;
+}
+
+bool OpeningBook::lookup(uint64_t key, BookEntry& out) const {
+    const BookEntry* end = this->entries + this->count;
+    const BookEntry* found = std::lower_bound(this->entries, end, key,
+                                              [](const BookEntry& entry, uint64_t k) { return entry.key < k; });
+    if (found == end || found->key != key) {
+        return false;
+    }
+    out = *found;
+    return true;
+}
+
+bool OpeningBook::lookup(const GameState& state, BookEntry& out) const {
+    if (this->count == 0 || state.gameOver ||
+        state.currentPieceOrientation != Orientation::NORTH ||
+        state.currentPieceX != PlacementSearch::SPAWN_X || state.currentPieceY != PlacementSearch::SPAWN_Y) {
+        return false;
+    }
+
+    TetrominoType hold = state.hasHeldPiece ? state.heldPieceType : TetrominoType::NONE;
+    uint64_t key = hashPosition(state.board, state.currentPieceType, hold, state.canHold,
+                                state.nextPieces[0], state.nextPieces[1]);
+    if (!this->lookup(key, out)) {
+        return false;
+    }
+
+    // Guard against hash collisions: the move must be for the piece that will be placed
+    TetrominoType placed = state.currentPieceType;
+    if (out.hold) {
+        placed = (hold != TetrominoType::NONE) ? hold : state.nextPieces[0];
+    }
+    return static_cast<TetrominoType>(out.type) == placed &&
+           PlacementSearch::fits(state.board, placed, static_cast<Orientation>(out.orientation), out.x, out.y);
+}
+
+uint64_t OpeningBook::hashPosition(const PlacementSearch::Board& board, TetrominoType current,
+                                   TetrominoType hold, bool canHold, TetrominoType next0, TetrominoType next1) {
+    uint64_t hash = 0;
+
+    // Occupancy only (colors don't matter), two rows per word
+    for (int row = 0; row < PlacementSearch::BOARD_HEIGHT; row += 2) {
+        uint64_t bits = 0;
+        for (int r = row; r < row + 2; r++) {
+            for (int col = 0; col < PlacementSearch::BOARD_WIDTH; col++) {
+                bits = (bits << 1) | (board[r][col] != 0 ? 1u : 0u);
+            }
+        }
+        hash = mix(hash, bits);
+    }
+
+    uint64_t pieces = static_cast<uint64_t>(current) | static_cast<uint64_t>(hold) << 4 |
+                      static_cast<uint64_t>(next0) << 8 | static_cast<uint64_t>(next1) << 12 |
+                      static_cast<uint64_t>(canHold ? 1 : 0) << 16;
+    return mix(hash, pieces);
+}
+
+bool OpeningBook::write(const std::string& path, std::vector<BookEntry>& entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const BookEntry& a, const BookEntry& b) { return a.key < b.key; });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [](const BookEntry& a, const BookEntry& b) { return a.key == b.key; }),
+                  entries.end());
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    BookHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.count = entries.size();
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(entries.data(), sizeof(BookEntry), entries.size(), file) == entries.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+Placement OpeningBook::toPlacement(const BookEntry& entry) {
+    return {static_cast<TetrominoType>(entry.type), static_cast<Orientation>(entry.orientation),
+            entry.x, entry.y, entry.rotations, entry.shift};
+}
@@ -0,0 +1,420 @@
+#include "bot/perfect_clear.hpp"
+#include "engine/piece_rotation.hpp"
+#include "engine/tetromino.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+    constexpr int WIDTH = PlacementSearch::BOARD_WIDTH;
+    constexpr uint64_t ROW_MASK = (1ull << WIDTH) - 1;
+    constexpr uint64_t COLUMN_0 = 0x0004010040100401ull;    // column 0 of rows 0-5
+    constexpr uint64_t COLUMN_9 = COLUMN_0 << (WIDTH - 1);
+    constexpr uint64_t EVEN_COLUMNS = 0x0555555555555555ull;           // columns 0, 2, ... of rows 0-5
+
+    // Largest change one piece can make to (even-column cells - odd-column
+    // cells); full rows have 5 of each, so line clears never change it
+    constexpr int COLUMN_PARITY_SWING[9] = {0, 4, 0, 2, 0, 0, 2, 2, 0};
+
+    // Positions searched per piece: x from -3, box top row up to 3 above the region
+    constexpr int MIN_X = -3;
+    constexpr int X_RANGE = WIDTH - MIN_X;
+    constexpr int TOP_RANGE = PerfectClearSolver::MAX_HEIGHT + 4;
+
+    struct Move {
+        uint64_t mask;
+        int orientation;
+        int x;
+        int top;
+    };
+
+    struct KickSet {
+        int count;
+        int offsets[PieceRotation::MAX_KICKS][2];
+    };
+
+    // Kick offsets per type, start orientation and direction (0 = clockwise)
+    struct KickTable {
+        KickSet sets[9][4][2];
+
+        KickTable() {
+            for (int type = 0; type < 9; type++) {
+                for (int from = 0; from < 4; from++) {
+                    for (int direction = 0; direction < 2; direction++) {
+                        Orientation start = static_cast<Orientation>(from);
+                        Orientation end = PieceRotation::getNextOrientation(start, direction == 0);
+                        KickSet& set = this->sets[type][from][direction];
+                        set.count = PieceRotation::getWallKicks(static_cast<TetrominoType>(type), start, end,
+                                                                set.offsets);
+                    }
+                }
+            }
+        }
+    };
+
+    const KickTable& getKicks() {
+        static const KickTable table;
+        return table;
+    }
+
+    uint64_t regionMask(int height) {
+        return (1ull << (height * WIDTH)) - 1;
+    }
+
+    int countCells(uint64_t board) {
+        return __builtin_popcountll(board);
+    }
+
+    // Cells of a piece inside the region; false if it leaves the walls or
+    // floor or overlaps the board (rows above the region are always empty)
+    bool pieceMask(TetrominoType type, int orientation, int x, int top, int height, uint64_t board,
+                   uint64_t& mask) {
+        const PieceShape& shape = Tetromino::getShape(type, static_cast<Orientation>(orientation));
+        if (x + shape.minCol < 0 || x + shape.maxCol >= WIDTH || top - shape.maxRow < 0) {
+            return false;
+        }
+
+        mask = 0;
+        for (int row = shape.minRow; row <= shape.maxRow; row++) {
+            int regionRow = top - row;
+            if (regionRow >= height) continue;
+
+            uint64_t bits = shape.getRowBits(row);
+            bits = (x >= 0) ? bits << x : bits >> -x;
+            mask |= bits << (regionRow * WIDTH);
+        }
+        return (mask & board) == 0;
+    }
+
+    // Every resting spot reachable from above the region by shifts, soft
+    // drops and kicked rotations, one per distinct set of cells
+    void generateMoves(uint64_t board, int height, TetrominoType type, std::vector<Move>& out) {
+        out.clear();
+
+        const KickTable& kicks = getKicks();
+        bool seen[4][X_RANGE][TOP_RANGE] = {};
+        Move queue[4 * X_RANGE * TOP_RANGE];
+        int head = 0;
+        int tail = 0;
+        int maxTop = height + 3;
+
+        auto visit = [&](int orientation, int x, int top) {
+            uint64_t mask;
+            if (x < MIN_X || x >= WIDTH || top < 0) return false;
+            // Higher up is open space: the game would take such a kick, but
+            // every position up there is already covered by the start row
+            if (top > maxTop) return pieceMask(type, orientation, x, top, height, board, mask);
+            if (seen[orientation][x - MIN_X][top]) return true;
+            if (!pieceMask(type, orientation, x, top, height, board, mask)) return false;
+
+            seen[orientation][x - MIN_X][top] = true;
+            queue[tail++] = {mask, orientation, x, top};
+            return true;
+        };
+
+        for (int orientation = 0; orientation < 4; orientation++) {
+            for (int x = MIN_X; x < WIDTH; x++) {
+                visit(orientation, x, maxTop);
+            }
+        }
+
+        while (head < tail) {
+            Move move = queue[head++];
+
+            visit(move.orientation, move.x - 1, move.top);
+            visit(move.orientation, move.x + 1, move.top);
+
+            for (int direction = 0; direction < 2; direction++) {
+                int next = (move.orientation + (direction == 0 ? 1 : 3)) % 4;
+                const KickSet& set = kicks.sets[static_cast<int>(type)][move.orientation][direction];
+
+                // Kicks use board rows (down is +y), the region counts up
+                for (int i = 0; i < set.count; i++) {
+                    if (visit(next, move.x + set.offsets[i][0], move.top - set.offsets[i][1])) break;
+                }
+            }
+
+            if (visit(move.orientation, move.x, move.top - 1)) continue;
+
+            // Resting: keep it if the whole piece is inside the region
+            const PieceShape& shape = Tetromino::getShape(type, static_cast<Orientation>(move.orientation));
+            if (move.top - shape.minRow >= height) continue;
+
+            bool duplicate = false;
+            for (const Move& other : out) {
+                if (other.mask == move.mask) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (!duplicate) {
+                out.push_back(move);
+            }
+        }
+
+        // Fill from the bottom up first
+        std::sort(out.begin(), out.end(), [](const Move& a, const Move& b) { return a.mask < b.mask; });
+    }
+
+    // Remove full rows; the rows above drop and the region shrinks
+    uint64_t clearRows(uint64_t board, int height, int& newHeight) {
+        uint64_t result = 0;
+        newHeight = 0;
+        for (int row = 0; row < height; row++) {
+            uint64_t bits = (board >> (row * WIDTH)) & ROW_MASK;
+            if (bits == ROW_MASK) continue;
+            result |= bits << (newHeight * WIDTH);
+            newHeight++;
+        }
+        return result;
+    }
+
+    // Each enclosed empty region must be fillable by whole tetrominoes
+    bool regionsFillable(uint64_t board, int height) {
+        uint64_t empty = ~board & regionMask(height);
+
+        while (empty != 0) {
+            uint64_t region = empty & (~empty + 1);
+            while (true) {
+                uint64_t grown = region | ((region << 1) & ~COLUMN_0) | ((region >> 1) & ~COLUMN_9) |
+                                 (region << WIDTH) | (region >> WIDTH);
+                grown &= empty;
+                if (grown == region) break;
+                region = grown;
+            }
+
+            if (countCells(region) % 4 != 0) {
+                return false;
+            }
+            empty &= ~region;
+        }
+
+        return true;
+    }
+
+    struct MemoKey {
+        uint64_t board;
+        uint32_t meta;
+
+        bool operator==(const MemoKey& other) const { return board == other.board && meta == other.meta; }
+    };
+
+    struct MemoHash {
+        std::size_t operator()(const MemoKey& key) const {
+            return static_cast<std::size_t>((key.board ^ (static_cast<uint64_t>(key.meta) << 59)) *
+                                            0x9e3779b97f4a7c15ull) ^ key.meta;
+        }
+    };
+
+    // A piece choice at one node: which type is placed and where the queue goes next
+    struct Choice {
+        TetrominoType type;
+        bool hold;
+        int nextIndex;
+        TetrominoType nextHold;
+    };
+
+    int listChoices(const std::vector<TetrominoType>& queue, int index, TetrominoType hold, bool allowHold,
+                    Choice out[2]) {
+        int count = 0;
+        int size = static_cast<int>(queue.size());
+        if (index >= size) return 0;
+
+        TetrominoType current = queue[index];
+        out[count++] = {current, false, index + 1, hold};
+
+        if (allowHold) {
+            if (hold != TetrominoType::NONE) {
+                if (hold != current) out[count++] = {hold, true, index + 1, current};
+            } else if (index + 1 < size && queue[index + 1] != current) {
+                out[count++] = {queue[index + 1], true, index + 2, current};
+            }
+        }
+        return count;
+    }
+
+    PerfectClearStep makeStep(const Choice& choice, const Move& move) {
+        Placement placement = {choice.type, static_cast<Orientation>(move.orientation), move.x,
+                               PlacementSearch::BOARD_HEIGHT - 1 - move.top, 0, 0};
+        return {placement, choice.hold};
+    }
+
+    class Searcher {
+    private:
+        const std::vector<TetrominoType>& queue;
+        const PerfectClearConfig& config;
+        const std::atomic<bool>& stop;
+        std::unordered_set<MemoKey, MemoHash> failed;
+        std::vector<std::vector<Move>> moves;
+        // Parity swing still available from queue[i..]
+        std::vector<int> swingLeft;
+
+    public:
+        std::vector<PerfectClearStep> path;
+        uint64_t nodes = 0;
+
+        Searcher(const std::vector<TetrominoType>& queue, const PerfectClearConfig& config,
+                 const std::atomic<bool>& stop)
+            : queue(queue), config(config), stop(stop), moves(config.maxPieces + 1),
+              swingLeft(queue.size() + 1, 0) {
+            for (std::size_t i = queue.size(); i > 0; i--) {
+                this->swingLeft[i - 1] = this->swingLeft[i] + COLUMN_PARITY_SWING[static_cast<int>(queue[i - 1])];
+            }
+        }
+
+        bool search(uint64_t board, int height, int index, TetrominoType hold, int depth) {
+            this->nodes++;
+            if (height == 0) return true;
+            if (this->stop.load(std::memory_order_relaxed)) return false;
+
+            // Enough pieces left to fill every empty cell?
+            int piecesNeeded = (height * WIDTH - countCells(board)) / 4;
+            int available = static_cast<int>(this->queue.size()) - index + (hold != TetrominoType::NONE ? 1 : 0);
+            if (piecesNeeded > std::min(available, this->config.maxPieces - depth)) return false;
+
+            // Can the remaining pieces even out the column parity?
+            uint64_t empty = ~board & regionMask(height);
+            int imbalance = countCells(empty & EVEN_COLUMNS) - countCells(empty & ~EVEN_COLUMNS);
+            int swing = this->swingLeft[std::min(static_cast<std::size_t>(index), this->queue.size())] +
+                        COLUMN_PARITY_SWING[static_cast<int>(hold)];
+            if (std::abs(imbalance) > swing) return false;
+
+            if (!regionsFillable(board, height)) return false;
+
+            MemoKey key = {board, static_cast<uint32_t>(height | (index << 3) | (static_cast<int>(hold) << 10))};
+            if (this->failed.count(key) != 0) return false;
+
+            Choice choices[2];
+            int choiceCount = listChoices(this->queue, index, hold, this->config.allowHold, choices);
+            std::vector<Move>& buffer = this->moves[depth];
+
+            for (int c = 0; c < choiceCount; c++) {
+                const Choice& choice = choices[c];
+                generateMoves(board, height, choice.type, buffer);
+
+                // Deeper levels use their own buffers, so this list stays intact
+                for (const Move& move : buffer) {
+                    int nextHeight;
+                    uint64_t next = clearRows(board | move.mask, height, nextHeight);
+
+                    this->path.push_back(makeStep(choice, move));
+                    if (this->search(next, nextHeight, choice.nextIndex, choice.nextHold, depth + 1)) {
+                        return true;
+                    }
+                    this->path.pop_back();
+                }
+            }
+
+            this->failed.insert(key);
+            return false;
+        }
+    };
+
+    struct RootJob {
+        Choice choice;
+        Move move;
+    };
+
+    bool solveHeight(uint64_t board, int height, const std::vector<TetrominoType>& queue, TetrominoType hold,
+                     const PerfectClearConfig& config, PerfectClearResult& result) {
+        if (!regionsFillable(board, height)) return false;
+
+        // Share the first placement out over the workers
+        std::vector<RootJob> jobs;
+        std::vector<Move> moves;
+        Choice choices[2];
+        int choiceCount = listChoices(queue, 0, hold, config.allowHold, choices);
+        for (int c = 0; c < choiceCount; c++) {
+            generateMoves(board, height, choices[c].type, moves);
+            for (const Move& move : moves) {
+                jobs.push_back({choices[c], move});
+            }
+        }
+
+        int threads = config.threads > 0 ? config.threads
+                                         : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        threads = std::max(1, std::min(threads, static_cast<int>(jobs.size())));
+
+        std::atomic<std::size_t> nextJob(0);
+        std::atomic<bool> stop(false);
+        std::atomic<uint64_t> nodes(0);
+        std::mutex resultMutex;
+
+        auto work = [&]() {
+            Searcher searcher(queue, config, stop);
+
+            while (!stop.load()) {
+                std::size_t j = nextJob.fetch_add(1);
+                if (j >= jobs.size()) break;
+
+                const RootJob& job = jobs[j];
+                int nextHeight;
+                uint64_t next = clearRows(board | job.move.mask, height, nextHeight);
+
+                searcher.path.assign(1, makeStep(job.choice, job.move));
+                if (searcher.search(next, nextHeight, job.choice.nextIndex, job.choice.nextHold, 1)) {
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    if (!stop.exchange(true)) {
+                        result.steps = searcher.path;
+                    }
+                    break;
+                }
+            }
+
+            nodes.fetch_add(searcher.nodes);
+        };
+
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        result.nodes += nodes.load();
+        return stop.load();
+    }
+}
+
+bool PerfectClearSolver::solve(const PlacementSearch::Board& board, const std::vector<TetrominoType>& queue,
+                               TetrominoType hold, const PerfectClearConfig& config, PerfectClearResult& result) {
+    result.found = false;
+    result.height = 0;
+    result.steps.clear();
+    result.nodes = 0;
+
+    // Pack the bottom rows; anything above them rules a perfect clear out
+    uint64_t packed = 0;
+    int stackHeight = 0;
+    for (int row = 0; row < PlacementSearch::BOARD_HEIGHT; row++) {
+        int regionRow = PlacementSearch::BOARD_HEIGHT - 1 - row;
+        for (int col = 0; col < WIDTH; col++) {
+            if (board[row][col] == 0) continue;
+            if (regionRow >= MAX_HEIGHT) return false;
+
+            packed |= 1ull << (regionRow * WIDTH + col);
+            stackHeight = std::max(stackHeight, regionRow + 1);
+        }
+    }
+
+    int cells = countCells(packed);
+    int maxHeight = std::min(config.maxHeight, static_cast<int>(MAX_HEIGHT));
+
+    // Lowest height first; the empty cells must split into whole pieces
+    for (int height = std::max(stackHeight, 1); height <= maxHeight; height++) {
+        if ((height * WIDTH - cells) % 4 != 0) continue;
+
+        if (solveHeight(packed, height, queue, hold, config, result)) {
+            result.found = true;
+            result.height = height;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,164 @@
+#include "bot/placement.hpp"
+#include "engine/piece_rotation.hpp"
+#include "engine/tetromino.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+bool PlacementSearch::fits(const Board& board, TetrominoType type, Orientation orientation,
+                           int x, int y) {
+    const PieceShape& shape = Tetromino::getShape(type, orientation);
+
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (!shape.isFilled(row, col)) continue;
+
+            int boardX = x + col;
+            int boardY = y + row;
+
+            if (boardX < 0 || boardX >= BOARD_WIDTH || boardY < 0 || boardY >= BOARD_HEIGHT) {
+                return false;
+            }
+            if (board[boardY][boardX] != 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void PlacementSearch::enumerate(const Board& board, TetrominoType type, Orientation orientation,
+                                int x, int y, std::vector<Placement>& out) {
+    out.clear();
+
+    // O never changes shape; I/S/Z only have two distinct shapes
+    static const int TURNS[4] = {0, 1, -1, 2};
+    int turnOptions = 4;
+    if (type == TetrominoType::O) turnOptions = 1;
+    else if (type == TetrominoType::I || type == TetrominoType::S || type == TetrominoType::Z) turnOptions = 2;
+
+    if (!fits(board, type, orientation, x, y)) {
+        return;
+    }
+
+    for (int option = 0; option < turnOptions; option++) {
+        int turns = TURNS[option];
+        bool clockwise = turns > 0;
+        Orientation current = orientation;
+        int pieceX = x;
+        int pieceY = y;
+        bool rotated = true;
+
+        // Rotate exactly like Game::tryRotate, kicks included
+        for (int t = 0; t < (turns < 0 ? -turns : turns) && rotated; t++) {
+            Orientation next = PieceRotation::getNextOrientation(current, clockwise);
+            rotated = false;
+
+            int kicks[PieceRotation::MAX_KICKS][2];
+            int kickCount = PieceRotation::getWallKicks(type, current, next, kicks);
+            for (int k = 0; k < kickCount; k++) {
+                if (fits(board, type, next, pieceX + kicks[k][0], pieceY + kicks[k][1])) {
+                    pieceX += kicks[k][0];
+                    pieceY += kicks[k][1];
+                    current = next;
+                    rotated = true;
+                    break;
+                }
+            }
+        }
+
+        if (!rotated) continue;
+
+        // Slide out in both directions until blocked
+        for (int direction = -1; direction <= 1; direction += 2) {
+            int shift = (direction < 0) ? 0 : 1;
+            while (fits(board, type, current, pieceX + shift, pieceY)) {
+                int landingY = pieceY;
+                while (fits(board, type, current, pieceX + shift, landingY + 1)) {
+                    landingY++;
+                }
+                out.push_back({type, current, pieceX + shift, landingY, turns, shift});
+                shift += direction;
+            }
+        }
+    }
+}
+
+void PlacementSearch::appendEvents(const Placement& placement, std::vector<GameEvent>& events) {
+    if (placement.rotations < 0) {
+        events.push_back(GameEvent::ROTATE_CCW);
+    }
+    for (int i = 0; i < placement.rotations; i++) {
+        events.push_back(GameEvent::ROTATE_CW);
+    }
+    for (int i = 0; i < placement.shift; i++) {
+        events.push_back(GameEvent::MOVE_RIGHT);
+    }
+    for (int i = 0; i > placement.shift; i--) {
+        events.push_back(GameEvent::MOVE_LEFT);
+    }
+    events.push_back(GameEvent::HARD_DROP);
+}
+
+BoardFeatures PlacementSearch::evaluate(const Board& board, const Placement& placement, Board& result) {
+    std::memcpy(result, board, sizeof(Board));
+
+    const PieceShape& shape = Tetromino::getShape(placement.type, placement.orientation);
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (shape.isFilled(row, col)) {
+                result[placement.y + row][placement.x + col] = static_cast<int>(placement.type);
+            }
+        }
+    }
+
+    BoardFeatures features = {};
+
+    // Clear full rows by compacting survivors downwards
+    int writeRow = BOARD_HEIGHT - 1;
+    for (int row = BOARD_HEIGHT - 1; row >= 0; row--) {
+        bool full = true;
+        for (int col = 0; col < BOARD_WIDTH; col++) {
+            if (result[row][col] == 0) {
+                full = false;
+                break;
+            }
+        }
+
+        if (full) {
+            features.linesCleared++;
+        } else {
+            if (writeRow != row) {
+                std::memcpy(result[writeRow], result[row], sizeof(result[0]));
+            }
+            writeRow--;
+        }
+    }
+    for (int row = writeRow; row >= 0; row--) {
+        std::memset(result[row], 0, sizeof(result[0]));
+    }
+
+    int previousHeight = -1;
+    for (int col = 0; col < BOARD_WIDTH; col++) {
+        int height = 0;
+        for (int row = 0; row < BOARD_HEIGHT; row++) {
+            if (result[row][col] != 0) {
+                if (height == 0) {
+                    height = BOARD_HEIGHT - row;
+                }
+            } else if (height != 0) {
+                features.holes++;
+            }
+        }
+
+        features.aggregateHeight += height;
+        features.maxHeight = std::max(features.maxHeight, height);
+        if (previousHeight >= 0) {
+            features.bumpiness += std::abs(height - previousHeight);
+        }
+        previousHeight = height;
+    }
+
+    return features;
+}
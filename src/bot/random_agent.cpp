@@ -0,0 +1,20 @@
+#include "bot/random_agent.hpp"
+
+RandomAgent::RandomAgent(uint32_t seed) : rng(seed) {
+    this->placements.reserve(64);
+    this->events.reserve(16);
+}
+
+void RandomAgent::think(const GameState& state, const Deadline&, AgentPlan& plan) {
+    PlacementSearch::enumerate(state.board, state.currentPieceType, state.currentPieceOrientation,
+                               state.currentPieceX, state.currentPieceY, this->placements);
+    if (this->placements.empty()) {
+        return;
+    }
+
+    std::uniform_int_distribution<std::size_t> pick(0, this->placements.size() - 1);
+
+    this->events.clear();
+    PlacementSearch::appendEvents(this->placements[pick(this->rng)], this->events);
+    plan.publish(this->events);
+}
@@ -0,0 +1,141 @@
+#include "bot/rollout.hpp"
+#include "bot/agent_factory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace {
+    constexpr float TICK_DELTA = 1.0f / 60.0f;
+
+    // Rollouts are handed out in chunks to keep the shared counter cold
+    constexpr int CHUNK = 64;
+
+    // SplitMix64: independent, well-mixed stream seeds from (seed, index)
+    uint64_t streamSeed(uint64_t seed, uint64_t index) {
+        uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    struct alignas(64) Totals {
+        uint64_t lines = 0;
+        uint64_t survived = 0;
+        uint64_t pieces = 0;
+    };
+}
+
+int RolloutResult::getScorePercentile(double quantile) const {
+    if (this->scores.empty()) {
+        return 0;
+    }
+    quantile = std::min(1.0, std::max(0.0, quantile));
+    return this->scores[static_cast<std::size_t>(quantile * (this->scores.size() - 1))];
+}
+
+bool RolloutAnalyzer::analyze(const Game& position, const RolloutConfig& config, RolloutResult& result) {
+    result = RolloutResult();
+    if (AgentFactory::create(config.policy, 0) == nullptr) {
+        return false;
+    }
+
+    int rollouts = std::max(0, config.rollouts);
+    int threadCount = config.threads > 0 ? config.threads
+                                         : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threadCount = std::max(1, std::min(threadCount, (rollouts + CHUNK - 1) / CHUNK));
+
+    // Each rollout writes its own slot, so threads never share a score
+    result.scores.assign(rollouts, 0);
+    std::vector<Totals> totals(threadCount);
+    std::atomic<int> nextRollout(0);
+
+    auto started = std::chrono::steady_clock::now();
+
+    auto worker = [&](int thread) {
+        std::unique_ptr<IAgent> agent = AgentFactory::create(config.policy, static_cast<uint32_t>(
+            streamSeed(config.seed, static_cast<uint64_t>(rollouts) + thread)));
+        AgentPlan plan;
+        std::vector<GameEvent> events;
+        events.reserve(16);
+        Game game = position;
+        Totals& local = totals[thread];
+
+        GameState start = position.getState();
+
+        for (;;) {
+            int first = nextRollout.fetch_add(CHUNK, std::memory_order_relaxed);
+            if (first >= rollouts) {
+                break;
+            }
+            int last = std::min(rollouts, first + CHUNK);
+
+            for (int i = first; i < last; i++) {
+                game = position;
+                game.reshuffleQueue(streamSeed(config.seed, static_cast<uint64_t>(i)));
+
+                int placed = 0;
+                while (placed < config.maxPieces && !game.isGameOver()) {
+                    GameState state = game.getState();
+                    Deadline deadline(config.budget, TICK_DELTA);
+                    plan.clear();
+                    agent->think(state, deadline, plan);
+
+                    // A policy with no move gives up the rollout
+                    if (!plan.take(events) || events.empty()) {
+                        break;
+                    }
+                    int locked = game.getPiecesLocked();
+                    for (GameEvent event : events) {
+                        game.handleEvent(event);
+                    }
+                    if (game.getPiecesLocked() == locked) {
+                        game.handleEvent(GameEvent::HARD_DROP);
+                    }
+                    placed++;
+                }
+
+                GameState end = game.getState();
+                result.scores[i] = end.score - start.score;
+                local.lines += static_cast<uint64_t>(end.linesCleared - start.linesCleared);
+                local.survived += end.gameOver ? 0 : 1;
+                local.pieces += static_cast<uint64_t>(placed);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; t++) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    result.rollouts = rollouts;
+    if (rollouts == 0) {
+        return true;
+    }
+
+    Totals sum;
+    for (const Totals& local : totals) {
+        sum.lines += local.lines;
+        sum.survived += local.survived;
+        sum.pieces += local.pieces;
+    }
+
+    double scoreTotal = 0.0;
+    for (int score : result.scores) {
+        scoreTotal += score;
+    }
+    std::sort(result.scores.begin(), result.scores.end());
+
+    result.expectedLines = static_cast<double>(sum.lines) / rollouts;
+    result.survivalRate = static_cast<double>(sum.survived) / rollouts;
+    result.meanScore = scoreTotal / rollouts;
+    result.pieces = sum.pieces;
+    return true;
+}
@@ -0,0 +1,218 @@
+#include "capi/tetris_engine.h"
+#include "engine/game.hpp"
+#include "engine/game_pool.hpp"
+#include <cstring>
+
+static_assert(sizeof(tetris_observation) == 256, "tetris_observation layout is part of the ABI");
+static_assert(offsetof(tetris_observation, piece) == 200, "tetris_observation layout is part of the ABI");
+static_assert(offsetof(tetris_observation, score) == 216, "tetris_observation layout is part of the ABI");
+static_assert(sizeof(tetris_observation) % TETRIS_OBSERVATION_ALIGN == 0, "observation arrays must stay aligned");
+
+struct tetris_game {
+    Game game;
+};
+
+struct tetris_batch {
+    GamePool pool;
+
+    explicit tetris_batch(int32_t count) : pool(static_cast<std::size_t>(count)) {}
+};
+
+// Reaches into Game (a friend) so observations skip the GameState copy
+class EngineBindings {
+public:
+    static void observe(const Game& game, tetris_observation& out) {
+        static_assert(sizeof(out.board) == sizeof(game.board), "board layouts must match");
+        std::memcpy(out.board, game.board, sizeof(out.board));
+
+        out.piece = static_cast<uint8_t>(game.currentPiece.getType());
+        out.orientation = static_cast<uint8_t>(game.currentPiece.getOrientation());
+        out.piece_x = static_cast<int8_t>(game.currentPiece.getX());
+        out.piece_y = static_cast<int8_t>(game.currentPiece.getY());
+        out.ghost_y = static_cast<int8_t>(game.calculateGhostY());
+        out.hold = static_cast<uint8_t>(game.heldType);
+        out.can_hold = game.canHold ? 1 : 0;
+        out.game_over = game.gameOver ? 1 : 0;
+
+        TetrominoType next[TETRIS_PREVIEW_COUNT];
+        game.generator.peek(next, TETRIS_PREVIEW_COUNT);
+        for (int i = 0; i < TETRIS_PREVIEW_COUNT; i++) {
+            out.next[i] = static_cast<uint8_t>(next[i]);
+        }
+
+        out.last_tspin = static_cast<uint8_t>(game.lastTSpin);
+        out.back_to_back = game.backToBack ? 1 : 0;
+        out.last_clear_count = static_cast<uint8_t>(game.lastClearCount);
+        out.score = game.score;
+        out.level = game.level;
+        out.lines_cleared = game.linesCleared;
+        out.pieces_locked = game.piecesLocked;
+        out.pending_garbage = game.pendingGarbage;
+        out.combo = game.combo;
+        std::memset(out.reserved, 0, sizeof(out.reserved));
+    }
+};
+
+namespace {
+    constexpr float TICK_DELTA = 1.0f / 60.0f;
+
+    bool isAligned(const void* pointer) {
+        return reinterpret_cast<uintptr_t>(pointer) % TETRIS_OBSERVATION_ALIGN == 0;
+    }
+
+    GameRules rulesFor(int32_t competitive) {
+        return competitive != 0 ? GameRules::competitive() : GameRules();
+    }
+
+    // Action codes line up with GameEvent after the NONE slot
+    void step(Game& game, int32_t action, int32_t ticks) {
+        if (action > TETRIS_ACTION_NONE && action < TETRIS_ACTION_COUNT) {
+            game.handleEvent(static_cast<GameEvent>(action - 1));
+        }
+        for (int32_t i = 0; i < ticks && !game.isGameOver(); i++) {
+            game.update(TICK_DELTA);
+        }
+    }
+
+    static_assert(static_cast<int>(GameEvent::MOVE_LEFT) == TETRIS_ACTION_LEFT - 1 &&
+                  static_cast<int>(GameEvent::MOVE_DOWN) == TETRIS_ACTION_SOFT_DROP - 1 &&
+                  static_cast<int>(GameEvent::HOLD) == TETRIS_ACTION_HOLD - 1,
+                  "action codes follow GameEvent");
+}
+
+extern "C" {
+
+uint32_t tetris_abi_version(void) {
+    return TETRIS_ABI_VERSION;
+}
+
+size_t tetris_observation_size(void) {
+    return sizeof(tetris_observation);
+}
+
+// No C++ exception may cross into the host: functions that can allocate
+// report failure through their return value instead
+
+tetris_game* tetris_game_create(uint32_t seed, int32_t competitive) {
+    try {
+        return new tetris_game{Game(seed, rulesFor(competitive))};
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void tetris_game_destroy(tetris_game* game) {
+    delete game;
+}
+
+int32_t tetris_game_reset(tetris_game* game, uint32_t seed) {
+    if (game == nullptr) return TETRIS_ERROR_INVALID;
+    try {
+        game->game.reset(seed);
+    } catch (...) {
+        return TETRIS_ERROR_INVALID;
+    }
+    return TETRIS_OK;
+}
+
+int32_t tetris_game_observe(const tetris_game* game, tetris_observation* out) {
+    if (game == nullptr || out == nullptr) return TETRIS_ERROR_INVALID;
+    if (!isAligned(out)) return TETRIS_ERROR_ALIGNMENT;
+    EngineBindings::observe(game->game, *out);
+    return TETRIS_OK;
+}
+
+int32_t tetris_game_step(tetris_game* game, int32_t action, int32_t ticks, tetris_observation* out) {
+    if (game == nullptr) return TETRIS_ERROR_INVALID;
+    if (out != nullptr && !isAligned(out)) return TETRIS_ERROR_ALIGNMENT;
+
+    step(game->game, action, ticks);
+    if (out != nullptr) {
+        EngineBindings::observe(game->game, *out);
+    }
+    return TETRIS_OK;
+}
+
+tetris_batch* tetris_batch_create(int32_t count, uint32_t seed, int32_t competitive) {
+    if (count <= 0 || count > TETRIS_MAX_BATCH_SIZE) return nullptr;
+
+    tetris_batch* batch = nullptr;
+    try {
+        batch = new tetris_batch(count);
+
+        // Every slot is in use for the batch's lifetime; slot i is game i
+        for (int32_t i = 0; i < count; i++) {
+            batch->pool.acquire(seed);
+        }
+        for (int32_t i = 0; i < count; i++) {
+            batch->pool[i].setRules(rulesFor(competitive));
+        }
+    } catch (...) {
+        delete batch;
+        return nullptr;
+    }
+
+    if (tetris_batch_reset(batch, seed) != TETRIS_OK) {
+        delete batch;
+        return nullptr;
+    }
+    return batch;
+}
+
+void tetris_batch_destroy(tetris_batch* batch) {
+    delete batch;
+}
+
+int32_t tetris_batch_size(const tetris_batch* batch) {
+    return batch != nullptr ? static_cast<int32_t>(batch->pool.getCapacity()) : 0;
+}
+
+int32_t tetris_batch_reset(tetris_batch* batch, uint32_t seed) {
+    if (batch == nullptr) return TETRIS_ERROR_INVALID;
+    try {
+        for (std::size_t i = 0; i < batch->pool.getCapacity(); i++) {
+            batch->pool[i].reset(seed + static_cast<uint32_t>(i));
+        }
+    } catch (...) {
+        return TETRIS_ERROR_INVALID;
+    }
+    return TETRIS_OK;
+}
+
+int32_t tetris_batch_observe(const tetris_batch* batch, tetris_observation* out) {
+    if (batch == nullptr || out == nullptr) return TETRIS_ERROR_INVALID;
+    if (!isAligned(out)) return TETRIS_ERROR_ALIGNMENT;
+
+    for (std::size_t i = 0; i < batch->pool.getCapacity(); i++) {
+        EngineBindings::observe(batch->pool[i], out[i]);
+    }
+    return TETRIS_OK;
+}
+
+int32_t tetris_batch_step(tetris_batch* batch, const int32_t* actions, int32_t ticks,
+                          tetris_observation* out, uint8_t* done, int32_t auto_reset) {
+    if (batch == nullptr || actions == nullptr) return TETRIS_ERROR_INVALID;
+    if (out != nullptr && !isAligned(out)) return TETRIS_ERROR_ALIGNMENT;
+
+    std::size_t count = batch->pool.getCapacity();
+    for (std::size_t i = 0; i < count; i++) {
+        Game& game = batch->pool[i];
+        bool wasOver = game.isGameOver();
+        step(game, actions[i], ticks);
+
+        bool ended = !wasOver && game.isGameOver();
+        if (done != nullptr) {
+            done[i] = ended ? 1 : 0;
+        }
+        if (auto_reset != 0 && game.isGameOver()) {
+            // Next seed derived from the finished game's, so runs stay reproducible
+            game.reset();
+        }
+        if (out != nullptr) {
+            EngineBindings::observe(game, out[i]);
+        }
+    }
+    return TETRIS_OK;
+}
+
+}
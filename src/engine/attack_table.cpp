@@ -0,0 +1,42 @@
+#include "engine/attack_table.hpp"
+#include <algorithm>
+
+int AttackTable::getAttack(int linesCleared, TSpinType tSpin, int combo, bool backToBack,
+                           bool perfectClear) {
+    if (linesCleared <= 0) {
+        return 0;
+    }
+
+    int lines = std::min(linesCleared, 4);
+    int attack;
+
+    switch (tSpin) {
+        case TSpinType::FULL:
+            attack = TSPIN_ATTACK[std::min(lines, 3)];
+            break;
+        case TSpinType::MINI:
+            attack = TSPIN_MINI_ATTACK[std::min(lines, 3)];
+            break;
+        default:
+            attack = LINE_CLEAR_ATTACK[lines];
+            break;
+    }
+
+    if (combo > 0) {
+        attack += COMBO_ATTACK[std::min(combo, 11)];
+    }
+
+    if (backToBack) {
+        attack += BACK_TO_BACK_BONUS;
+    }
+
+    if (perfectClear) {
+        attack += PERFECT_CLEAR_BONUS;
+    }
+
+    return attack;
+}
+
+bool AttackTable::isDifficultClear(int linesCleared, TSpinType tSpin) {
+    return linesCleared >= 4 || (linesCleared > 0 && tSpin != TSpinType::NONE);
+}
@@ -1,61 +1,134 @@
 #include "engine/game.hpp"
 #include "engine/piece_rotation.hpp"
+#include "engine/attack_table.hpp"
+#include "engine/metrics.hpp"
 #include <cstring>
 #include <algorithm>
 
-Game::Game()
-    : canHold(true), score(0), level(1), linesCleared(0),
-      gameOver(false), dropTimer(0.0f), dropInterval(1.0f) {
-    std::memset(this->board, 0, sizeof(this->board));
+namespace {
+    // Garbage holes use their own stream so they don't shift the piece order
+    constexpr uint32_t GARBAGE_SEED_SALT = 0x9e3779b9u;
+
+    // Seed for the next game after a restart (PCG step)
+    uint32_t nextSeed(uint32_t seed) {
+        return seed * 747796405u + 2891336453u;
+    }
+
+    // Points per level (index = lines cleared)
+    constexpr int LINE_POINTS[5] = {0, 40, 100, 300, 1200};
+    constexpr int TSPIN_POINTS[4] = {400, 800, 1200, 1600};
+    constexpr int TSPIN_MINI_POINTS[4] = {100, 200, 400, 400};
+    constexpr int PERFECT_CLEAR_POINTS[5] = {0, 800, 1200, 1800, 2000};
+    constexpr int COMBO_POINTS = 50;
+
+    // The final SRS kick test turns a mini T-spin into a full one
+    constexpr int LAST_KICK_INDEX = 4;
+
+    // Corner bits around the T's centre: 1 top-left, 2 top-right,
+    // 4 bottom-left, 8 bottom-right. These are the two the T points at.
+    constexpr int T_FRONT_CORNERS[4] = {0x3, 0xa, 0xc, 0x5};
+
+    // Process-wide engine counters (one relaxed add each on the hot path,
+    // for games with metrics enabled)
+    Metrics::Counter& TICKS = Metrics::global().counter(
+        "tetris_ticks_total", "Game ticks simulated");
+    Metrics::Counter& INPUTS = Metrics::global().counter(
+        "tetris_inputs_total", "Input events handled");
+    Metrics::Counter& PIECES_LOCKED = Metrics::global().counter(
+        "tetris_pieces_locked_total", "Pieces locked");
+    Metrics::Counter& LINES_CLEARED = Metrics::global().counter(
+        "tetris_lines_cleared_total", "Lines cleared");
+    Metrics::Counter& GAMES_STARTED = Metrics::global().counter(
+        "tetris_games_started_total", "Games started (construction or reset)");
+    Metrics::Counter& GAMES_ENDED = Metrics::global().counter(
+        "tetris_games_ended_total", "Games that topped out");
+}
+
+Game::Game() : Game(std::random_device()()) {}
+
+Game::Game(uint32_t seed, const GameRules& rules)
+    : heldType(TetrominoType::NONE), canHold(true), generator(seed, rules.randomizer), score(0), level(1), linesCleared(0),
+      piecesLocked(0), gameOver(false), rules(rules), dropTimer(0.0f), dropInterval(1.0f),
+      lockTimer(0.0f), lockResets(0), lowestY(0),
+      garbageHead(0), garbageEntries(0), pendingGarbage(0), outgoingGarbage(0),
+      combo(-1), backToBack(false), garbageRng(seed ^ GARBAGE_SEED_SALT),
+      lastKickIndex(-1), lastTSpin(TSpinType::NONE), lastPerfectClear(false), seed(seed), metricsOwner(nullptr) {
+    this->clearBoard();
     this->spawnNextPiece();
 }
 
+void Game::setMetricsEnabled(bool enabled) {
+    if (enabled && !this->isMetricsEnabled()) {
+        GAMES_STARTED.add();
+    }
+    this->metricsOwner = enabled ? this : nullptr;
+}
+
 void Game::reset() {
-    std::memset(this->board, 0, sizeof(this->board));
+    this->reset(nextSeed(this->seed));
+}
+
+void Game::reset(uint32_t seed) {
+    this->seed = seed;
+    this->clearBoard();
     this->score = 0;
     this->level = 1;
     this->linesCleared = 0;
+    this->piecesLocked = 0;
     this->gameOver = false;
     this->dropTimer = 0.0f;
     this->dropInterval = 1.0f;
     this->canHold = true;
-    this->heldPiece.reset();
-
-    this->generator = PieceGenerator();
+    this->heldType = TetrominoType::NONE;
+
+    this->garbageHead = 0;
+    this->garbageEntries = 0;
+    this->pendingGarbage = 0;
+    this->outgoingGarbage = 0;
+    this->combo = -1;
+    this->backToBack = false;
+    this->garbageRng.seed(seed ^ GARBAGE_SEED_SALT);
+    this->lastTSpin = TSpinType::NONE;
+    this->lastPerfectClear = false;
+
+    this->generator = PieceGenerator(seed, this->rules.randomizer);
     this->spawnNextPiece();
+    if (this->isMetricsEnabled()) GAMES_STARTED.add();
 }
 
 void Game::update(float deltaTime) {
     if (this->gameOver) {
         return;
     }
+    if (this->isMetricsEnabled()) TICKS.add();
 
-    this->dropTimer += deltaTime;
-
-    if (this->dropTimer >= this->dropInterval) {
-        this->dropTimer = 0.0f;
+    bool hasLockDelay = this->rules.lockDelay > 0.0f;
 
-        if (!this->tryMoveDown()) {
-            this->lockPiece();
-            int cleared = this->clearLines();
+    if (this->isTwentyG()) {
+        // The piece lands the tick it appears
+        this->dropToFloor();
+        if (!hasLockDelay) {
+            this->finishPiece();
+            return;
+        }
+    } else {
+        this->dropTimer += deltaTime;
 
-            if (cleared > 0) {
-                // Update score based on lines cleared
-                int points[] = {0, 40, 100, 300, 1200};
-                this->score += points[cleared] * this->level;
-                this->linesCleared += cleared;
+        if (this->dropTimer >= this->dropInterval) {
+            this->dropTimer = 0.0f;
 
-                // Level up every 10 lines
-                this->level = (this->linesCleared / 10) + 1;
-                this->updateDropInterval();
+            if (!this->tryMoveDown() && !hasLockDelay) {
+                this->finishPiece();
+                return;
             }
+        }
+    }
 
-            this->spawnNextPiece();
-            this->canHold = true;
-
-            if (!this->isValidPosition(this->currentPiece)) {
-                this->gameOver = true;
-            }
+    // Grounded pieces lock once the delay runs out
+    if (hasLockDelay && !this->isValidPosition(this->currentPiece, 0, 1)) {
+        this->lockTimer += deltaTime;
+        if (this->lockTimer >= this->rules.lockDelay) {
+            this->finishPiece();
         }
     }
 }
@@ -64,6 +137,7 @@ void Game::handleEvent(GameEvent event) {
     if (this->gameOver && event != GameEvent::RESTART) {
         return;
     }
+    if (this->isMetricsEnabled()) INPUTS.add();
 
     switch (event) {
         case GameEvent::MOVE_LEFT:
@@ -99,19 +173,22 @@ GameState Game::getState() const {
     GameState state;
 
     // Copy board
-    std::memcpy(state.board, this->board, sizeof(this->board));
+    for (int row = 0; row < BOARD_HEIGHT; row++) {
+        for (int col = 0; col < BOARD_WIDTH; col++) {
+            state.board[row][col] = this->board[row][col];
+        }
+    }
 
     // Current piece info
-    this->currentPiece.getShape(state.currentPieceShape);
     state.currentPieceType = this->currentPiece.getType();
     state.currentPieceOrientation = this->currentPiece.getOrientation();
     state.currentPieceX = this->currentPiece.getX();
     state.currentPieceY = this->currentPiece.getY();
 
     // Hold piece info
-    state.hasHeldPiece = this->heldPiece.has_value();
+    state.hasHeldPiece = this->heldType != TetrominoType::NONE;
     state.canHold = this->canHold;
-    state.heldPieceType = this->heldPiece.has_value() ? this->heldPiece->getType() : TetrominoType::NONE;
+    state.heldPieceType = this->heldType;
 
     // Next pieces
     state.nextPieces = this->generator.getPreview();
@@ -123,8 +200,20 @@ GameState Game::getState() const {
     state.score = this->score;
     state.level = this->level;
     state.linesCleared = this->linesCleared;
+    state.piecesLocked = this->piecesLocked;
     state.gameOver = this->gameOver;
 
+    state.pendingGarbage = this->pendingGarbage;
+
+    state.lastTSpin = this->lastTSpin;
+    state.lastPerfectClear = this->lastPerfectClear;
+    state.combo = this->combo;
+    state.backToBack = this->backToBack;
+
+    // Last line clear (for animations)
+    state.lastClearCount = this->lastClearCount;
+    std::memcpy(state.lastClearedRows.data(), this->lastClearedRows, sizeof(this->lastClearedRows));
+
     return state;
 }
 
@@ -133,28 +222,25 @@ bool Game::isValidPosition(const Tetromino& piece) const {
 }
 
 bool Game::isValidPosition(const Tetromino& piece, int offsetX, int offsetY) const {
-    int shape[4][4];
-    piece.getShape(shape);
+    const PieceShape& shape = piece.getShape();
 
     int pieceX = piece.getX() + offsetX;
     int pieceY = piece.getY() + offsetY;
 
-    for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-            if (shape[row][col] != 0) {
-                int boardX = pieceX + col;
-                int boardY = pieceY + row;
+    // Check bounds once against the bounding box
+    if (pieceX + shape.minCol < 0 || pieceX + shape.maxCol >= BOARD_WIDTH ||
+        pieceY + shape.minRow < 0 || pieceY + shape.maxRow >= BOARD_HEIGHT) {
+        return false;
+    }
 
-                // Check bounds
-                if (boardX < 0 || boardX >= BOARD_WIDTH ||
-                    boardY < 0 || boardY >= BOARD_HEIGHT) {
-                    return false;
-                }
+    // Check collision with locked pieces
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        uint16_t bits = shape.getRowBits(row);
+        const uint8_t* boardRow = this->board[pieceY + row] + pieceX;
 
-                // Check collision with locked pieces
-                if (this->board[boardY][boardX] != 0) {
-                    return false;
-                }
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (((bits >> col) & 1) != 0 && boardRow[col] != 0) {
+                return false;
             }
         }
     }
@@ -163,22 +249,30 @@ bool Game::isValidPosition(const Tetromino& piece, int offsetX, int offsetY) con
 }
 
 void Game::lockPiece() {
-    int shape[4][4];
-    this->currentPiece.getShape(shape);
+    const PieceShape& shape = this->currentPiece.getShape();
 
     int pieceX = this->currentPiece.getX();
     int pieceY = this->currentPiece.getY();
-    int pieceType = static_cast<int>(this->currentPiece.getType());
+    uint8_t pieceType = static_cast<uint8_t>(this->currentPiece.getType());
 
-    for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-            if (shape[row][col] != 0) {
+    this->lockTopRow = BOARD_HEIGHT;
+    this->lockBottomRow = -1;
+
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (shape.isFilled(row, col)) {
                 int boardX = pieceX + col;
                 int boardY = pieceY + row;
 
                 if (boardX >= 0 && boardX < BOARD_WIDTH &&
                     boardY >= 0 && boardY < BOARD_HEIGHT) {
                     this->board[boardY][boardX] = pieceType;
+                    this->rowFill[boardY]++;
+                    this->filledCells++;
+                    this->columnTop[boardX] = std::min<uint8_t>(this->columnTop[boardX], boardY);
+
+                    this->lockTopRow = std::min(this->lockTopRow, boardY);
+                    this->lockBottomRow = std::max(this->lockBottomRow, boardY);
                 }
             }
         }
@@ -186,46 +280,97 @@ void Game::lockPiece() {
 }
 
 int Game::clearLines() {
-    int cleared = 0;
+    this->lastClearCount = 0;
 
-    for (int row = BOARD_HEIGHT - 1; row >= 0; row--) {
-        bool fullLine = true;
-
-        for (int col = 0; col < BOARD_WIDTH; col++) {
-            if (this->board[row][col] == 0) {
-                fullLine = false;
-                break;
-            }
+    // Only rows the last piece touched can have become full
+    for (int row = this->lockBottomRow; row >= this->lockTopRow; row--) {
+        if (this->rowFill[row] == BOARD_WIDTH) {
+            this->lastClearedRows[this->lastClearCount++] = row;
         }
+    }
 
-        if (fullLine) {
-            cleared++;
-
-            // Move all rows above down
-            for (int r = row; r > 0; r--) {
-                for (int col = 0; col < BOARD_WIDTH; col++) {
-                    this->board[r][col] = this->board[r - 1][col];
-                }
-            }
-
-            // Clear top row
-            for (int col = 0; col < BOARD_WIDTH; col++) {
-                this->board[0][col] = 0;
-            }
+    int cleared = this->lastClearCount;
+    if (cleared == 0) {
+        return 0;
+    }
 
-            // Check this row again
-            row++;
+    // Compact in one pass: each run of surviving rows between two cleared
+    // rows moves down once, by the number of cleared rows below it
+    for (int i = 0; i < cleared; i++) {
+        int shift = i + 1;
+        int runBottom = this->lastClearedRows[i] - 1;
+        int runTop = (i + 1 < cleared) ? this->lastClearedRows[i + 1] + 1 : 0;
+        int runLength = runBottom - runTop + 1;
+
+        if (runLength > 0) {
+            std::memmove(this->board[runTop + shift], this->board[runTop],
+                         sizeof(this->board[0]) * runLength);
+            std::memmove(&this->rowFill[runTop + shift], &this->rowFill[runTop],
+                         sizeof(this->rowFill[0]) * runLength);
         }
     }
 
+    // Empty the rows vacated at the top
+    std::memset(this->board[0], 0, sizeof(this->board[0]) * cleared);
+    std::memset(this->rowFill, 0, sizeof(this->rowFill[0]) * cleared);
+
+    this->filledCells -= cleared * BOARD_WIDTH;
+    this->updateColumnTops();
+
     return cleared;
 }
 
+void Game::clearBoard() {
+    std::memset(this->board, 0, sizeof(this->board));
+    std::memset(this->rowFill, 0, sizeof(this->rowFill));
+    std::memset(this->columnTop, BOARD_HEIGHT, sizeof(this->columnTop));
+    this->lockTopRow = BOARD_HEIGHT;
+    this->lockBottomRow = -1;
+    this->lastClearCount = 0;
+    std::memset(this->lastClearedRows, 0, sizeof(this->lastClearedRows));
+    this->filledCells = 0;
+}
+
 void Game::spawnNextPiece() {
     this->currentPiece = this->generator.getNext();
+    this->resetLockState();
+    this->lastKickIndex = -1;
+    this->pushEvent(EngineEventType::PIECE_SPAWNED);
+}
+
+EngineEvent& Game::pushEvent(EngineEventType type, int detail, int value) {
+    EngineEvent& event = this->events.push();
+    event.type = type;
+    event.piece = this->currentPiece.getType();
+    event.orientation = this->currentPiece.getOrientation();
+    event.x = static_cast<int8_t>(this->currentPiece.getX());
+    event.y = static_cast<int8_t>(this->currentPiece.getY());
+    event.detail = static_cast<int8_t>(detail);
+    event.value = static_cast<uint16_t>(value);
+    return event;
 }
 
 int Game::calculateGhostY() const {
+    const PieceShape& shape = this->currentPiece.getShape();
+    int pieceX = this->currentPiece.getX();
+    int pieceY = this->currentPiece.getY();
+
+    // Rest the lowest cell of each column on that column's top
+    int landingY = BOARD_HEIGHT;
+    for (int col = shape.minCol; col <= shape.maxCol; col++) {
+        int boardX = pieceX + col;
+        if (boardX < 0 || boardX >= BOARD_WIDTH) {
+            continue;
+        }
+        landingY = std::min(landingY, this->columnTop[boardX] - 1 - shape.columnBottom[col]);
+    }
+
+    // Above the stack in every column the lookup is exact; a piece tucked
+    // under an overhang has to be walked down instead
+    if (landingY >= pieceY) {
+        return landingY;
+    }
+
     Tetromino ghost = this->currentPiece;
 
     while (this->isValidPosition(ghost, 0, 1)) {
@@ -235,14 +380,68 @@ int Game::calculateGhostY() const {
     return ghost.getY();
 }
 
+void Game::updateColumnTops() {
+    // Skip the empty rows at the top, then find each column's highest cell
+    int firstRow = 0;
+    while (firstRow < BOARD_HEIGHT && this->rowFill[firstRow] == 0) {
+        firstRow++;
+    }
+
+    for (int col = 0; col < BOARD_WIDTH; col++) {
+        int row = firstRow;
+        while (row < BOARD_HEIGHT && this->board[row][col] == 0) {
+            row++;
+        }
+        this->columnTop[col] = static_cast<uint8_t>(row);
+    }
+}
+
 void Game::updateDropInterval() {
     // Decrease drop interval as level increases
     this->dropInterval = std::max(0.1f, 1.0f - (this->level - 1) * 0.05f);
 }
 
+bool Game::isTwentyG() const {
+    return this->rules.twentyGLevel > 0 && this->level >= this->rules.twentyGLevel;
+}
+
+void Game::dropToFloor() {
+    int landingY = this->calculateGhostY();
+    if (landingY != this->currentPiece.getY()) {
+        this->currentPiece.setPosition(this->currentPiece.getX(), landingY);
+        this->onPieceMoved();
+    }
+}
+
+void Game::resetLockState() {
+    this->lockTimer = 0.0f;
+    this->lockResets = 0;
+    this->lowestY = this->currentPiece.getY();
+}
+
+void Game::onPieceMoved() {
+    // Any movement after a rotation rules out a spin
+    this->lastKickIndex = -1;
+    this->pushEvent(EngineEventType::PIECE_MOVED);
+    this->extendLockDelay();
+}
+
+void Game::extendLockDelay() {
+    if (this->currentPiece.getY() > this->lowestY) {
+        // Reaching a new lowest row gives the piece a fresh set of resets
+        this->lowestY = this->currentPiece.getY();
+        this->lockResets = 0;
+        this->lockTimer = 0.0f;
+    } else if (this->lockTimer > 0.0f && this->lockResets < this->rules.maxLockResets) {
+        this->lockResets++;
+        this->lockTimer = 0.0f;
+    }
+}
+
 bool Game::tryMoveLeft() {
     if (isValidPosition(this->currentPiece, -1, 0)) {
         this->currentPiece.moveLeft();
+        this->onPieceMoved();
         return true;
     }
     return false;
@@ -251,6 +450,7 @@ bool Game::tryMoveLeft() {
 bool Game::tryMoveRight() {
     if (isValidPosition(this->currentPiece, 1, 0)) {
         this->currentPiece.moveRight();
+        this->onPieceMoved();
         return true;
     }
     return false;
@@ -259,6 +459,7 @@ bool Game::tryMoveRight() {
 bool Game::tryMoveDown() {
     if (this->isValidPosition(this->currentPiece, 0, 1)) {
         this->currentPiece.moveDown();
+        this->onPieceMoved();
         return true;
     }
     return false;
@@ -269,23 +470,29 @@ bool Game::tryRotate(bool clockwise) {
     Orientation newOri = PieceRotation::getNextOrientation(currentOri, clockwise);
 
     // Get wall kicks for this rotation
-    std::vector<std::pair<int, int>> kicks = PieceRotation::getWallKicks(
+    int kicks[PieceRotation::MAX_KICKS][2];
+    int kickCount = PieceRotation::getWallKicks(
         this->currentPiece.getType(),
         currentOri,
-        newOri
+        newOri,
+        kicks
     );
 
     // Try each kick offset
-    for (const std::pair<int, int>& kick : kicks) {
+    for (int i = 0; i < kickCount; i++) {
         Tetromino testPiece = this->currentPiece;
         testPiece.setOrientation(newOri);
         testPiece.setPosition(
-            this->currentPiece.getX() + kick.first,
-            this->currentPiece.getY() + kick.second
+            this->currentPiece.getX() + kicks[i][0],
+            this->currentPiece.getY() + kicks[i][1]
         );
 
         if (this->isValidPosition(testPiece)) {
             this->currentPiece = testPiece;
+            // PIECE_ROTATED alone reports the change, not a PIECE_MOVED as well
+            this->extendLockDelay();
+            this->lastKickIndex = i;
+            this->pushEvent(EngineEventType::PIECE_ROTATED, i);
             return true;
         }
     }
@@ -299,16 +506,122 @@ void Game::performHardDrop() {
 
     this->currentPiece.setPosition(this->currentPiece.getX(), ghostY);
     this->score += distance * 2; // Hard drop bonus
+    if (distance > 0) {
+        this->lastKickIndex = -1;
+        this->pushEvent(EngineEventType::PIECE_MOVED);
+    }
+
+    this->finishPiece();
+    this->dropTimer = 0.0f;
+}
+
+bool Game::isOccupied(int x, int y) const {
+    // Walls and floor count as filled
+    if (x < 0 || x >= BOARD_WIDTH || y < 0 || y >= BOARD_HEIGHT) {
+        return true;
+    }
+    return this->board[y][x] != 0;
+}
+
+TSpinType Game::detectTSpin() const {
+    if (this->currentPiece.getType() != TetrominoType::T || this->lastKickIndex < 0) {
+        return TSpinType::NONE;
+    }
+
+    // The T's centre is the middle of its 3x3 box in every orientation
+    int x = this->currentPiece.getX();
+    int y = this->currentPiece.getY();
+    int corners = (this->isOccupied(x, y) ? 0x1 : 0) |
+                  (this->isOccupied(x + 2, y) ? 0x2 : 0) |
+                  (this->isOccupied(x, y + 2) ? 0x4 : 0) |
+                  (this->isOccupied(x + 2, y + 2) ? 0x8 : 0);
+
+    int count = (corners & 1) + ((corners >> 1) & 1) + ((corners >> 2) & 1) + ((corners >> 3) & 1);
+    if (count < 3) {
+        return TSpinType::NONE;
+    }
+
+    int front = T_FRONT_CORNERS[static_cast<int>(this->currentPiece.getOrientation())];
+    if ((corners & front) == front || this->lastKickIndex == LAST_KICK_INDEX) {
+        return TSpinType::FULL;
+    }
+    return TSpinType::MINI;
+}
+
+void Game::finishPiece() {
+    TSpinType tSpin = this->detectTSpin();
 
     this->lockPiece();
+    this->piecesLocked++;
+    this->pushEvent(EngineEventType::PIECE_LOCKED);
+    if (this->isMetricsEnabled()) PIECES_LOCKED.add();
     int cleared = this->clearLines();
 
     if (cleared > 0) {
-        int points[] = {0, 40, 100, 300, 1200};
-        this->score += points[cleared] * this->level;
+        // Rows come bottom-up and all lie within the piece's four rows
+        int lowest = this->lastClearedRows[0];
+        int rows = 0;
+        for (int i = 0; i < cleared; i++) {
+            rows |= 1 << (lowest - this->lastClearedRows[i]);
+        }
+        this->pushEvent(EngineEventType::LINES_CLEARED, cleared, rows).y = static_cast<int8_t>(lowest);
+    }
+
+    this->lastTSpin = tSpin;
+    this->lastPerfectClear = cleared > 0 && this->filledCells == 0;
+
+    if (cleared > 0) {
+        // Update score based on lines cleared and how they were cleared
+        this->combo++;
+        bool difficult = AttackTable::isDifficultClear(cleared, tSpin);
+        bool chained = difficult && this->backToBack;
+
+        int points;
+        switch (tSpin) {
+            case TSpinType::FULL:
+                points = TSPIN_POINTS[std::min(cleared, 3)];
+                break;
+            case TSpinType::MINI:
+                points = TSPIN_MINI_POINTS[std::min(cleared, 3)];
+                break;
+            default:
+                points = LINE_POINTS[cleared];
+                break;
+        }
+        if (chained) {
+            points = points * 3 / 2;
+        }
+        points += COMBO_POINTS * this->combo;
+        if (this->lastPerfectClear) {
+            points += PERFECT_CLEAR_POINTS[cleared];
+        }
+        this->score += points * this->level;
         this->linesCleared += cleared;
+        if (this->isMetricsEnabled()) LINES_CLEARED.add(cleared);
+
+        // Level up every 10 lines
+        int previousLevel = this->level;
         this->level = (this->linesCleared / 10) + 1;
         this->updateDropInterval();
+        if (this->level != previousLevel) {
+            this->pushEvent(EngineEventType::LEVEL_CHANGED, 0, this->level);
+        }
+
+        // Attack: chain bonuses, then cancel incoming garbage before sending
+        int attack = AttackTable::getAttack(cleared, tSpin, this->combo, chained,
+                                            this->lastPerfectClear);
+        this->backToBack = difficult;
+        this->outgoingGarbage += this->cancelGarbage(attack);
+    } else {
+        // T-spins score even without clearing a line
+        if (tSpin == TSpinType::FULL) {
+            this->score += TSPIN_POINTS[0] * this->level;
+        } else if (tSpin == TSpinType::MINI) {
+            this->score += TSPIN_MINI_POINTS[0] * this->level;
+        }
+
+        this->combo = -1;
+        this->applyGarbage();
     }
 
     this->spawnNextPiece();
@@ -317,8 +630,107 @@ void Game::performHardDrop() {
     if (!this->isValidPosition(this->currentPiece)) {
         this->gameOver = true;
     }
+    // Garbage pushed past the top ends the game too
+    if (this->gameOver) {
+        this->pushEvent(EngineEventType::TOP_OUT);
+        if (this->isMetricsEnabled()) GAMES_ENDED.add();
+    }
+}
 
-    this->dropTimer = 0.0f;
+void Game::receiveGarbage(int lines) {
+    if (lines <= 0) {
+        return;
+    }
+
+    std::uniform_int_distribution<int> column(0, BOARD_WIDTH - 1);
+    int hole = column(this->garbageRng);
+
+    if (this->garbageEntries == MAX_GARBAGE_ENTRIES) {
+        // Queue full: merge into the newest entry instead of allocating
+        int newest = (this->garbageHead + this->garbageEntries - 1) % MAX_GARBAGE_ENTRIES;
+        this->garbageQueue[newest].lines += lines;
+    } else {
+        int tail = (this->garbageHead + this->garbageEntries) % MAX_GARBAGE_ENTRIES;
+        this->garbageQueue[tail] = {lines, hole};
+        this->garbageEntries++;
+    }
+
+    this->pendingGarbage += lines;
+}
+
+int Game::takeOutgoingGarbage() {
+    int lines = this->outgoingGarbage;
+    this->outgoingGarbage = 0;
+    return lines;
+}
+
+int Game::cancelGarbage(int attack) {
+    // Remove lines from the oldest incoming attacks first
+    while (attack > 0 && this->garbageEntries > 0) {
+        GarbageEntry& entry = this->garbageQueue[this->garbageHead];
+        int cancelled = std::min(attack, entry.lines);
+
+        entry.lines -= cancelled;
+        attack -= cancelled;
+        this->pendingGarbage -= cancelled;
+
+        if (entry.lines == 0) {
+            this->garbageHead = (this->garbageHead + 1) % MAX_GARBAGE_ENTRIES;
+            this->garbageEntries--;
+        }
+    }
+
+    return attack;
+}
+
+void Game::applyGarbage() {
+    int budget = GARBAGE_CAP_PER_PIECE;
+
+    while (budget > 0 && this->garbageEntries > 0 && !this->gameOver) {
+        GarbageEntry& entry = this->garbageQueue[this->garbageHead];
+        int lines = std::min(budget, entry.lines);
+
+        this->insertGarbageRows(lines, entry.holeColumn);
+
+        entry.lines -= lines;
+        budget -= lines;
+        this->pendingGarbage -= lines;
+
+        if (entry.lines == 0) {
+            this->garbageHead = (this->garbageHead + 1) % MAX_GARBAGE_ENTRIES;
+            this->garbageEntries--;
+        }
+    }
+}
+
+void Game::insertGarbageRows(int lines, int holeColumn) {
+    lines = std::min(lines, BOARD_HEIGHT);
+
+    // Blocks pushed off the top end the game
+    for (int row = 0; row < lines; row++) {
+        if (this->rowFill[row] != 0) {
+            this->gameOver = true;
+            this->filledCells -= this->rowFill[row];
+        }
+    }
+    this->filledCells += lines * (BOARD_WIDTH - 1);
+
+    // Shift the whole stack up in one block move
+    std::memmove(this->board[0], this->board[lines],
+                 sizeof(this->board[0]) * (BOARD_HEIGHT - lines));
+    std::memmove(this->rowFill, &this->rowFill[lines],
+                 sizeof(this->rowFill[0]) * (BOARD_HEIGHT - lines));
+
+    uint8_t garbageRow[BOARD_WIDTH];
+    std::memset(garbageRow, static_cast<int>(TetrominoType::GARBAGE), sizeof(garbageRow));
+    garbageRow[holeColumn] = 0;
+
+    for (int row = BOARD_HEIGHT - lines; row < BOARD_HEIGHT; row++) {
+        std::memcpy(this->board[row], garbageRow, sizeof(garbageRow));
+        this->rowFill[row] = BOARD_WIDTH - 1;
+    }
+
+    this->updateColumnTops();
 }
 
 void Game::performHold() {
@@ -327,15 +739,19 @@ void Game::performHold() {
     }
 
     this->canHold = false;
+    this->pushEvent(EngineEventType::HOLD_USED);
 
-    if (this->heldPiece.has_value()) {
+    if (this->heldType != TetrominoType::NONE) {
         // Swap current piece with held piece
-        Tetromino temp = this->currentPiece;
-        this->currentPiece = Tetromino(this->heldPiece->getType(), SPAWN_X, SPAWN_Y);
-        this->heldPiece = Tetromino(temp.getType(), 0, 0);
+        TetrominoType swapped = this->heldType;
+        this->heldType = this->currentPiece.getType();
+        this->currentPiece = Tetromino(swapped, SPAWN_X, SPAWN_Y);
+        this->resetLockState();
+        this->lastKickIndex = -1;
+        this->pushEvent(EngineEventType::PIECE_SPAWNED);
     } else {
         // Store current piece and spawn new one
-        this->heldPiece = Tetromino(this->currentPiece.getType(), 0, 0);
+        this->heldType = this->currentPiece.getType();
         this->spawnNextPiece();
     }
 }
@@ -0,0 +1,135 @@
+#include "engine/game_history.hpp"
+#include <algorithm>
+
+GameHistory::GameHistory(Game& game, const HistoryConfig& config)
+    : game(game), config(config), oldest(0), count(0), currentTick(0) {
+    this->config.keyframeInterval = std::max(1, this->config.keyframeInterval);
+
+    // Budget each keyframe for its snapshot plus a few inputs per tick
+    std::size_t inputsPerKeyframe = static_cast<std::size_t>(this->config.keyframeInterval) * 4;
+    std::size_t keyframeCost = sizeof(Keyframe) + inputsPerKeyframe * sizeof(LoggedInput);
+    std::size_t capacity = std::max<std::size_t>(2, this->config.memoryBudget / keyframeCost);
+
+    this->keyframes.resize(capacity);
+    for (Keyframe& keyframe : this->keyframes) {
+        keyframe.inputs.reserve(inputsPerKeyframe);
+    }
+
+    this->pushKeyframe();
+}
+
+void GameHistory::update(float deltaTime) {
+    this->game.update(deltaTime);
+    this->currentTick++;
+
+    if (this->currentTick % this->config.keyframeInterval == 0) {
+        this->pushKeyframe();
+    }
+}
+
+void GameHistory::handleEvent(GameEvent event) {
+    this->game.handleEvent(event);
+
+    if (event == GameEvent::RESTART) {
+        // A restart draws a fresh bag, so it cannot be replayed; snapshot instead
+        this->pushKeyframe(true);
+    } else {
+        this->logInput(InputKind::EVENT, static_cast<int>(event));
+    }
+}
+
+GameState GameHistory::getState() const {
+    return this->game.getState();
+}
+
+int GameHistory::readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const {
+    return this->game.readEvents(cursor, out, capacity);
+}
+
+uint64_t GameHistory::getEventCursor() const {
+    return this->game.getEventCursor();
+}
+
+void GameHistory::receiveGarbage(int lines) {
+    this->game.receiveGarbage(lines);
+    this->logInput(InputKind::GARBAGE, lines);
+}
+
+int GameHistory::getOldestTick() const {
+    return this->keyframes[this->oldest].tick;
+}
+
+GameState GameHistory::getStateAt(int tick) const {
+    if (tick >= this->currentTick) {
+        return this->game.getState();
+    }
+
+    const Keyframe* keyframe = this->findKeyframe(tick);
+    if (keyframe == nullptr) {
+        return this->keyframes[this->oldest].snapshot.getState();
+    }
+
+    Game replay = keyframe->snapshot;
+    std::size_t next = 0;
+
+    for (int t = keyframe->tick; t < tick; t++) {
+        while (next < keyframe->inputs.size() && keyframe->inputs[next].tick == t) {
+            const LoggedInput& input = keyframe->inputs[next++];
+            if (input.kind == InputKind::EVENT) {
+                replay.handleEvent(static_cast<GameEvent>(input.value));
+            } else {
+                replay.receiveGarbage(input.value);
+            }
+        }
+        replay.update(this->config.tickDelta);
+    }
+
+    return replay.getState();
+}
+
+void GameHistory::clear() {
+    this->oldest = 0;
+    this->count = 0;
+    this->pushKeyframe();
+}
+
+void GameHistory::pushKeyframe(bool afterRestart) {
+    int capacity = static_cast<int>(this->keyframes.size());
+    int slot;
+
+    if (this->count < capacity) {
+        slot = (this->oldest + this->count) % capacity;
+        this->count++;
+    } else {
+        // Full: overwrite the oldest keyframe (its input buffer is reused)
+        slot = this->oldest;
+        this->oldest = (this->oldest + 1) % capacity;
+    }
+
+    Keyframe& keyframe = this->keyframes[slot];
+    keyframe.tick = this->currentTick;
+    keyframe.afterRestart = afterRestart;
+    keyframe.snapshot = this->game;
+    keyframe.inputs.clear();
+}
+
+void GameHistory::logInput(InputKind kind, int value) {
+    int capacity = static_cast<int>(this->keyframes.size());
+    int newest = (this->oldest + this->count - 1) % capacity;
+
+    this->keyframes[newest].inputs.push_back({this->currentTick, kind, value});
+}
+
+const GameHistory::Keyframe* GameHistory::findKeyframe(int tick) const {
+    int capacity = static_cast<int>(this->keyframes.size());
+
+    // Newest keyframe at or before the tick (ticks increase around the ring)
+    for (int i = this->count - 1; i >= 0; i--) {
+        const Keyframe& keyframe = this->keyframes[(this->oldest + i) % capacity];
+        if (keyframe.tick < tick || (keyframe.tick == tick && !keyframe.afterRestart)) {
+            return &keyframe;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,31 @@
+#include "engine/game_pool.hpp"
+
+GamePool::GamePool(std::size_t capacity) {
+    // Seeds don't matter here, every game is reseeded on acquire
+    this->games.reserve(capacity);
+    this->freeSlots.reserve(capacity);
+
+    for (std::size_t i = 0; i < capacity; i++) {
+        this->games.emplace_back(static_cast<uint32_t>(i));
+    }
+    for (std::size_t i = capacity; i > 0; i--) {
+        this->freeSlots.push_back(static_cast<uint32_t>(i - 1));
+    }
+}
+
+Game* GamePool::acquire(uint32_t seed) {
+    if (this->freeSlots.empty()) {
+        return nullptr;
+    }
+
+    uint32_t slot = this->freeSlots.back();
+    this->freeSlots.pop_back();
+
+    Game* game = &this->games[slot];
+    game->reset(seed);
+    return game;
+}
+
+void GamePool::release(Game* game) {
+    this->freeSlots.push_back(static_cast<uint32_t>(this->getSlot(game)));
+}
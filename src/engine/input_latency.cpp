@@ -0,0 +1,170 @@
+#include "engine/input_latency.hpp"
+#include <algorithm>
+
+InputLatencyProbe::InputLatencyProbe(const IGameEngine& engine)
+    : engine(engine), eventCursor(engine.getEventCursor()), ticks(0),
+      lastX(engine.getState().currentPieceX), lastY(engine.getState().currentPieceY), ignored(0) {
+}
+
+bool InputLatencyProbe::matches(GameEvent event, const EngineEvent& effect) const {
+    // Moves are told apart by what they changed, so a shift into a wall is
+    // not credited with a gravity step or a later shift in the same batch
+    switch (event) {
+        case GameEvent::MOVE_LEFT:
+            return effect.type == EngineEventType::PIECE_MOVED && effect.x < this->lastX;
+        case GameEvent::MOVE_RIGHT:
+            return effect.type == EngineEventType::PIECE_MOVED && effect.x > this->lastX;
+        case GameEvent::MOVE_DOWN:
+            return effect.type == EngineEventType::PIECE_MOVED && effect.y > this->lastY;
+        case GameEvent::ROTATE_CW:
+        case GameEvent::ROTATE_CCW:
+            return effect.type == EngineEventType::PIECE_ROTATED;
+        case GameEvent::HARD_DROP:
+            return effect.type == EngineEventType::PIECE_LOCKED;
+        case GameEvent::HOLD:
+            return effect.type == EngineEventType::HOLD_USED;
+        case GameEvent::RESTART:
+            return effect.type == EngineEventType::PIECE_SPAWNED;
+    }
+    return false;
+}
+
+void InputLatencyProbe::recordKey(GameEvent event, Clock::time_point pressed) {
+    this->pending.push_back({event, pressed, pressed, this->ticks, false});
+}
+
+void InputLatencyProbe::readEvents(Clock::time_point handedBefore, Clock::time_point now) {
+    EngineEvent events[32];
+    int count;
+    while ((count = this->engine.readEvents(this->eventCursor, events, 32)) > 0) {
+        // Each event applies the oldest input just handed over that it could come from
+        for (int i = 0; i < count; i++) {
+            for (Pending& input : this->pending) {
+                if (!input.isApplied && input.pressed < handedBefore && this->matches(input.event, events[i])) {
+                    input.applied = now;
+                    input.isApplied = true;
+                    this->ticksToApply.push_back(static_cast<double>(this->ticks - input.tick));
+                    break;
+                }
+            }
+            this->lastX = events[i].x;
+            this->lastY = events[i].y;
+        }
+    }
+}
+
+void InputLatencyProbe::recordInputs(Clock::time_point handedBefore, Clock::time_point now) {
+    this->readEvents(handedBefore, now);
+
+    // An input shows its effect in the step that hands it over or never
+    auto ineffective = [handedBefore](const Pending& input) {
+        return !input.isApplied && input.pressed < handedBefore;
+    };
+    auto end = std::remove_if(this->pending.begin(), this->pending.end(), ineffective);
+    this->ignored += static_cast<int>(this->pending.end() - end);
+    this->pending.erase(end, this->pending.end());
+}
+
+void InputLatencyProbe::recordStep(Clock::time_point now) {
+    // Nothing was handed over, so no waiting input can match
+    this->readEvents(Clock::time_point::min(), now);
+}
+
+void InputLatencyProbe::recordTick(Clock::time_point now) {
+    this->ticks++;
+    this->recordStep(now);
+}
+
+void InputLatencyProbe::recordFrame(Clock::time_point now) {
+    auto micros = [](Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    // Every input recorded so far has reached the engine by now, so any
+    // still waiting changed nothing
+    for (const Pending& input : this->pending) {
+        if (!input.isApplied) {
+            this->ignored++;
+            continue;
+        }
+        this->toApply.push_back(micros(input.applied - input.pressed));
+        this->toDisplay.push_back(micros(now - input.applied));
+        this->total.push_back(micros(now - input.pressed));
+    }
+    this->pending.clear();
+}
+
+double InputLatencyProbe::getTotalPercentile(double quantile) const {
+    if (this->total.empty()) {
+        return 0.0;
+    }
+    std::vector<double> samples = this->total;
+    auto nth = samples.begin() + static_cast<std::ptrdiff_t>(quantile * (samples.size() - 1));
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+
+void InputLatencyProbe::printStage(std::FILE* out, const char* name, std::vector<double> samples, const char* unit) {
+    if (samples.empty()) {
+        std::fprintf(out, "  %-18s no samples\n", name);
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double quantile) {
+        return samples[static_cast<std::size_t>(quantile * (samples.size() - 1))];
+    };
+    std::fprintf(out, "  %-18s p50 %8.1f  p90 %8.1f  p99 %8.1f  max %8.1f %s\n", name,
+                 at(0.5), at(0.9), at(0.99), samples.back(), unit);
+}
+
+void InputLatencyProbe::report(std::FILE* out) const {
+    std::fprintf(out, "input latency: %d inputs displayed, %d had no effect\n",
+                 this->getSampleCount(), this->ignored);
+    printStage(out, "key -> applied", this->toApply, "us");
+    printStage(out, "applied -> shown", this->toDisplay, "us");
+    printStage(out, "key -> shown", this->total, "us");
+    printStage(out, "ticks to apply", this->ticksToApply, "ticks");
+}
+
+InputInjector::InputInjector(double rate, uint32_t seed)
+    : stopping(false), random(seed), rate(rate) {
+    this->worker = std::thread(&InputInjector::workerLoop, this);
+}
+
+InputInjector::~InputInjector() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+    this->worker.join();
+}
+
+void InputInjector::workerLoop() {
+    // Mostly shifts and rotations, with the occasional drop and hold
+    static const GameEvent KEYS[] = {
+        GameEvent::MOVE_LEFT, GameEvent::MOVE_LEFT, GameEvent::MOVE_RIGHT, GameEvent::MOVE_RIGHT,
+        GameEvent::ROTATE_CW, GameEvent::ROTATE_CCW, GameEvent::MOVE_DOWN, GameEvent::HARD_DROP,
+        GameEvent::HOLD
+    };
+    std::exponential_distribution<double> gap(this->rate);
+    std::uniform_int_distribution<int> key(0, static_cast<int>(sizeof(KEYS) / sizeof(KEYS[0])) - 1);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    auto next = InputLatencyProbe::Clock::now();
+    while (!this->stopping) {
+        next += std::chrono::duration_cast<InputLatencyProbe::Clock::duration>(
+            std::chrono::duration<double>(gap(this->random)));
+        if (this->wake.wait_until(lock, next, [this]() { return this->stopping; })) {
+            break;
+        }
+        this->queue.push_back({KEYS[key(this->random)], InputLatencyProbe::Clock::now()});
+    }
+}
+
+void InputInjector::poll(std::vector<Input>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(this->mutex);
+    out.swap(this->queue);
+}
@@ -0,0 +1,146 @@
+#include "engine/metrics.hpp"
+#include <cstdio>
+
+namespace Metrics {
+    uint64_t Counter::read() const {
+        uint64_t total = 0;
+        for (const Cell& cell : this->shards) {
+            total += cell.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    int64_t Gauge::read() const {
+        // Shards wrap independently; the sum is exact modulo 2^64
+        uint64_t total = 0;
+        for (const Cell& cell : this->shards) {
+            total += cell.value.load(std::memory_order_relaxed);
+        }
+        return static_cast<int64_t>(total);
+    }
+
+    Histogram::Histogram(const std::vector<double>& bounds) : bounds(bounds) {
+        if (this->bounds.size() > MAX_BUCKETS) {
+            this->bounds.resize(MAX_BUCKETS);
+        }
+        for (Shard& shard : this->shards) {
+            for (std::atomic<uint64_t>& bucket : shard.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            shard.sumNanoseconds.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Histogram::read(std::vector<uint64_t>& counts, double& sumSeconds) const {
+        counts.assign(this->bounds.size() + 1, 0);
+        uint64_t sum = 0;
+        for (const Shard& shard : this->shards) {
+            for (std::size_t i = 0; i < counts.size(); i++) {
+                counts[i] += shard.buckets[i].load(std::memory_order_relaxed);
+            }
+            sum += shard.sumNanoseconds.load(std::memory_order_relaxed);
+        }
+        sumSeconds = static_cast<double>(sum) * 1e-9;
+    }
+
+    std::vector<double> latencyBounds() {
+        return {1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+                1e-3, 2.5e-3, 5e-3, 1e-2, 5e-2, 0.25, 1.0};
+    }
+
+    void* Registry::find(const std::string& name, Kind kind) const {
+        for (const Entry& entry : this->entries) {
+            if (entry.name == name && entry.kind == kind) {
+                return entry.metric;
+            }
+        }
+        return nullptr;
+    }
+
+    Counter& Registry::counter(const std::string& name, const std::string& help) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (void* existing = this->find(name, Kind::COUNTER)) {
+            return *static_cast<Counter*>(existing);
+        }
+        this->counters.emplace_back();
+        this->entries.push_back({name, help, Kind::COUNTER, &this->counters.back()});
+        return this->counters.back();
+    }
+
+    Gauge& Registry::gauge(const std::string& name, const std::string& help) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (void* existing = this->find(name, Kind::GAUGE)) {
+            return *static_cast<Gauge*>(existing);
+        }
+        this->gauges.emplace_back();
+        this->entries.push_back({name, help, Kind::GAUGE, &this->gauges.back()});
+        return this->gauges.back();
+    }
+
+    Histogram& Registry::histogram(const std::string& name, const std::string& help,
+                                   const std::vector<double>& bounds) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (void* existing = this->find(name, Kind::HISTOGRAM)) {
+            return *static_cast<Histogram*>(existing);
+        }
+        this->histograms.emplace_back(bounds);
+        this->entries.push_back({name, help, Kind::HISTOGRAM, &this->histograms.back()});
+        return this->histograms.back();
+    }
+
+    std::string Registry::writePrometheus() const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::string out;
+        char line[256];
+        std::vector<uint64_t> counts;
+
+        for (const Entry& entry : this->entries) {
+            static const char* TYPES[3] = {"counter", "gauge", "histogram"};
+            out += "# HELP " + entry.name + " " + entry.help + "\n";
+            out += "# TYPE " + entry.name + " " + TYPES[static_cast<int>(entry.kind)] + "\n";
+
+            switch (entry.kind) {
+                case Kind::COUNTER:
+                    std::snprintf(line, sizeof(line), "%s %llu\n", entry.name.c_str(),
+                                  static_cast<unsigned long long>(static_cast<Counter*>(entry.metric)->read()));
+                    out += line;
+                    break;
+                case Kind::GAUGE:
+                    std::snprintf(line, sizeof(line), "%s %lld\n", entry.name.c_str(),
+                                  static_cast<long long>(static_cast<Gauge*>(entry.metric)->read()));
+                    out += line;
+                    break;
+                case Kind::HISTOGRAM: {
+                    const Histogram& histogram = *static_cast<Histogram*>(entry.metric);
+                    double sum;
+                    histogram.read(counts, sum);
+
+                    // Prometheus buckets are cumulative
+                    uint64_t cumulative = 0;
+                    for (std::size_t i = 0; i < counts.size(); i++) {
+                        cumulative += counts[i];
+                        if (i < histogram.getBounds().size()) {
+                            std::snprintf(line, sizeof(line), "%s_bucket{le=\"%g\"} %llu\n", entry.name.c_str(),
+                                          histogram.getBounds()[i], static_cast<unsigned long long>(cumulative));
+                        } else {
+                            std::snprintf(line, sizeof(line), "%s_bucket{le=\"+Inf\"} %llu\n", entry.name.c_str(),
+                                          static_cast<unsigned long long>(cumulative));
+                        }
+                        out += line;
+                    }
+                    std::snprintf(line, sizeof(line), "%s_sum %.9f\n%s_count %llu\n", entry.name.c_str(), sum,
+                                  entry.name.c_str(), static_cast<unsigned long long>(cumulative));
+                    out += line;
+                    break;
+                }
+            }
+        }
+
+        return out;
+    }
+
+    Registry& global() {
+        static Registry registry;
+        return registry;
+    }
+}
@@ -1,42 +1,57 @@
 #include "engine/piece_generator.hpp"
-#include <algorithm>
-#include <random>
+#include <cstring>
 
-PieceGenerator::PieceGenerator() : bagIndex(7) {
-    // Initialize random number generator
-    std::random_device rd;
-    this->rng = std::mt19937(rd());
+namespace {
+    const char* const RANDOMIZER_NAMES[] = {"7bag", "14bag", "history", "random"};
+}
+
+PieceGenerator::PieceGenerator(uint32_t seed, RandomizerKind kind) : randomizer(makeRandomizer(kind)) {
+    this->rng.seed(seed);
 
     // Fill initial preview
     for (int i = 0; i < 2; i++) {
-        this->preview[i] = this->getNextFromBag();
+        this->preview[i] = this->draw();
+    }
+}
+
+PieceGenerator::Randomizer PieceGenerator::makeRandomizer(RandomizerKind kind) {
+    switch (kind) {
+        case RandomizerKind::FOURTEEN_BAG: return FourteenBagRandomizer();
+        case RandomizerKind::HISTORY: return HistoryRandomizer();
+        case RandomizerKind::RANDOM: return UniformRandomizer();
+        default: return SevenBagRandomizer();
     }
 }
 
-void PieceGenerator::refillBag() {
-    // Fill bag with one of each piece type
-    this->bag = {
-        TetrominoType::I,
-        TetrominoType::O,
-        TetrominoType::T,
-        TetrominoType::S,
-        TetrominoType::Z,
-        TetrominoType::J,
-        TetrominoType::L
-    };
+const char* PieceGenerator::getRandomizerName(RandomizerKind kind) {
+    return RANDOMIZER_NAMES[static_cast<int>(kind)];
+}
 
-    // Shuffle the bag
-    std::shuffle(this->bag.begin(), this->bag.end(), this->rng);
-    this->bagIndex = 0;
+bool PieceGenerator::parseRandomizer(const char* name, RandomizerKind& kind) {
+    for (int i = 0; i < 4; i++) {
+        if (std::strcmp(name, RANDOMIZER_NAMES[i]) == 0) {
+            kind = static_cast<RandomizerKind>(i);
+            return true;
+        }
+    }
+    return false;
 }
 
-TetrominoType PieceGenerator::getNextFromBag() {
-    // Refill bag if empty
-    if (this->bagIndex >= 7) {
-        this->refillBag();
+TetrominoType PieceGenerator::draw() {
+    return std::visit([this](auto& randomizer) { return randomizer.next(this->rng); }, this->randomizer);
+}
+
+void PieceGenerator::peek(TetrominoType* out, int count) const {
+    // The generator is deterministic, so a copy replays the same sequence
+    PieceGenerator copy = *this;
+    for (int i = 0; i < count; i++) {
+        out[i] = copy.getNext().getType();
     }
+}
 
-    return this->bag[this->bagIndex++];
+void PieceGenerator::reshuffle(uint64_t seed) {
+    this->rng.seed(seed);
+    std::visit([this](auto& randomizer) { randomizer.reshuffle(this->rng); }, this->randomizer);
 }
 
 Tetromino PieceGenerator::getNext() {
@@ -45,7 +60,7 @@ Tetromino PieceGenerator::getNext() {
 
     // Shift preview and add new piece at the end
     this->preview[0] = this->preview[1];
-    this->preview[1] = this->getNextFromBag();
+    this->preview[1] = this->draw();
 
     // Create tetromino at spawn position
     return Tetromino(nextType, 3, 0);
@@ -5,12 +5,27 @@ std::vector<std::pair<int, int>> PieceRotation::getWallKicks(
     Orientation fromOrientation,
     Orientation toOrientation
 ) {
+    int offsets[MAX_KICKS][2];
+    int count = getWallKicks(type, fromOrientation, toOrientation, offsets);
+
     std::vector<std::pair<int, int>> kicks;
+    for (int i = 0; i < count; i++) {
+        kicks.push_back({offsets[i][0], offsets[i][1]});
+    }
+    return kicks;
+}
 
+int PieceRotation::getWallKicks(
+    TetrominoType type,
+    Orientation fromOrientation,
+    Orientation toOrientation,
+    int outKicks[MAX_KICKS][2]
+) {
     // O piece doesn't rotate
     if (type == TetrominoType::O) {
-        kicks.push_back({0, 0});
-        return kicks;
+        outKicks[0][0] = 0;
+        outKicks[0][1] = 0;
+        return 1;
     }
 
     int fromIndex = static_cast<int>(fromOrientation);
@@ -33,29 +48,22 @@ std::vector<std::pair<int, int>> PieceRotation::getWallKicks(
         tableIndex = 2;
     } else {
         // Shouldn't happen with valid rotations
-        kicks.push_back({0, 0});
-        return kicks;
+        outKicks[0][0] = 0;
+        outKicks[0][1] = 0;
+        return 1;
     }
 
-    // Select appropriate kick table
-    if (type == TetrominoType::I) {
-        for (int i = 0; i < 5; i++) {
-            kicks.push_back({
-                I_KICKS[tableIndex][kickIndex][i][0],
-                I_KICKS[tableIndex][kickIndex][i][1]
-            });
-        }
-    } else {
-        // J, L, S, T, Z all use the same table
-        for (int i = 0; i < 5; i++) {
-            kicks.push_back({
-                JLSTZ_KICKS[tableIndex][kickIndex][i][0],
-                JLSTZ_KICKS[tableIndex][kickIndex][i][1]
-            });
-        }
+    // Select appropriate kick table (J, L, S, T, Z all share one)
+    const int (*table)[2] = (type == TetrominoType::I)
+        ? I_KICKS[tableIndex][kickIndex]
+        : JLSTZ_KICKS[tableIndex][kickIndex];
+
+    for (int i = 0; i < MAX_KICKS; i++) {
+        outKicks[i][0] = table[i][0];
+        outKicks[i][1] = table[i][1];
     }
 
-    return kicks;
+    return MAX_KICKS;
 }
 
 Orientation PieceRotation::getNextOrientation(Orientation current, bool clockwise) {
@@ -0,0 +1,146 @@
+#include "engine/replay.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const char MAGIC[6] = {'T', 'R', 'P', 'L', 'Y', '\0'};
+
+    struct ReplayHeader {
+        char magic[6];
+        uint16_t version;
+        uint32_t seed;
+        uint32_t tickRate;
+        float lockDelay;
+        int32_t maxLockResets;
+        int32_t twentyGLevel;
+        uint32_t ticks;
+        uint32_t count;
+        // Zero (the 7-bag) in files written before randomizers were selectable
+        uint8_t randomizer;
+        uint8_t reserved[3];
+    };
+
+    static_assert(sizeof(ReplayHeader) == 40, "replay header must stay 40 bytes");
+    static_assert(sizeof(ReplayInput) == 8, "replay inputs must stay 8 bytes");
+}
+
+bool Replay::save(const std::string& path) const {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    ReplayHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.seed = this->seed;
+    header.tickRate = static_cast<uint32_t>(this->tickRate);
+    header.lockDelay = this->rules.lockDelay;
+    header.maxLockResets = this->rules.maxLockResets;
+    header.twentyGLevel = this->rules.twentyGLevel;
+    header.ticks = static_cast<uint32_t>(this->ticks);
+    header.count = static_cast<uint32_t>(this->inputs.size());
+    header.randomizer = static_cast<uint8_t>(this->rules.randomizer);
+    std::memset(header.reserved, 0, sizeof(header.reserved));
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(this->inputs.data(), sizeof(ReplayInput), this->inputs.size(), file) ==
+                  this->inputs.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+bool Replay::load(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    ReplayHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+              header.tickRate > 0 && header.randomizer <= static_cast<uint8_t>(RandomizerKind::RANDOM);
+
+    // The input count must match the file size before anything is allocated
+    if (ok) {
+        long headerEnd = std::ftell(file);
+        ok = headerEnd >= 0 && std::fseek(file, 0, SEEK_END) == 0;
+        long fileEnd = ok ? std::ftell(file) : -1;
+        ok = ok && fileEnd >= headerEnd &&
+             static_cast<uint64_t>(fileEnd - headerEnd) ==
+                 static_cast<uint64_t>(header.count) * sizeof(ReplayInput) &&
+             std::fseek(file, headerEnd, SEEK_SET) == 0;
+    }
+
+    if (ok) {
+        this->inputs.resize(header.count);
+        ok = std::fread(this->inputs.data(), sizeof(ReplayInput), this->inputs.size(), file) ==
+             this->inputs.size();
+    }
+    std::fclose(file);
+    if (!ok) {
+        return false;
+    }
+
+    this->seed = header.seed;
+    this->tickRate = static_cast<int>(header.tickRate);
+    this->rules.lockDelay = header.lockDelay;
+    this->rules.maxLockResets = header.maxLockResets;
+    this->rules.twentyGLevel = header.twentyGLevel;
+    this->rules.randomizer = static_cast<RandomizerKind>(header.randomizer);
+    this->ticks = static_cast<int>(header.ticks);
+
+    // Inputs must be in tick order and name real events
+    uint32_t previous = 0;
+    for (const ReplayInput& input : this->inputs) {
+        if (input.tick < previous || input.event > static_cast<uint8_t>(GameEvent::RESTART)) {
+            return false;
+        }
+        previous = input.tick;
+    }
+    return true;
+}
+
+ReplayRecorder::ReplayRecorder(IGameEngine& engine, const Game& game, int tickRate) : engine(engine) {
+    this->replay.seed = game.getSeed();
+    this->replay.rules = game.getRules();
+    this->replay.tickRate = tickRate;
+}
+
+void ReplayRecorder::update(float deltaTime) {
+    this->engine.update(deltaTime);
+    this->replay.ticks++;
+}
+
+void ReplayRecorder::handleEvent(GameEvent event) {
+    this->engine.handleEvent(event);
+    this->replay.inputs.push_back({static_cast<uint32_t>(this->replay.ticks), static_cast<uint8_t>(event), {}});
+}
+
+GameState ReplayRecorder::getState() const {
+    return this->engine.getState();
+}
+
+int ReplayRecorder::readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const {
+    return this->engine.readEvents(cursor, out, capacity);
+}
+
+uint64_t ReplayRecorder::getEventCursor() const {
+    return this->engine.getEventCursor();
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& replay)
+    : replay(replay), game(replay.seed, replay.rules), nextInput(0), tick(0) {}
+
+bool ReplayPlayer::step() {
+    if (this->isFinished()) {
+        return false;
+    }
+
+    while (this->nextInput < this->replay.inputs.size() &&
+           this->replay.inputs[this->nextInput].tick == static_cast<uint32_t>(this->tick)) {
+        this->game.handleEvent(static_cast<GameEvent>(this->replay.inputs[this->nextInput++].event));
+    }
+    this->game.update(1.0f / static_cast<float>(this->replay.tickRate));
+    this->tick++;
+    return true;
+}
@@ -0,0 +1,86 @@
+#include "engine/simulation_loop.hpp"
+#include "engine/metrics.hpp"
+#include <algorithm>
+
+namespace {
+    Metrics::Gauge& PENDING_INPUTS = Metrics::global().gauge(
+        "tetris_pending_inputs", "Timestamped inputs waiting for their tick");
+}
+
+SimulationLoop::SimulationLoop(IGameEngine& engine, int tickRate)
+    : engine(engine), started(false), previous(engine.getState()), alpha(0.0f), latencyProbe(nullptr) {
+    this->setTickRate(tickRate);
+}
+
+void SimulationLoop::setTickRate(int ticksPerSecond) {
+    this->tickRate = std::max(1, ticksPerSecond);
+    this->tickDelta = 1.0f / static_cast<float>(this->tickRate);
+    this->tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / this->tickRate;
+}
+
+void SimulationLoop::push(GameEvent event, Clock::time_point time) {
+    // Usually appended; an input stamped earlier than queued ones is sorted in
+    auto position = std::upper_bound(this->inputs.begin(), this->inputs.end(), time,
+        [](Clock::time_point value, const TimedInput& input) { return value < input.time; });
+    this->inputs.insert(position, {event, time});
+    PENDING_INPUTS.add(1);
+}
+
+int SimulationLoop::applyInputs(Clock::time_point before) {
+    int applied = 0;
+    while (!this->inputs.empty() && this->inputs.front().time < before) {
+        this->engine.handleEvent(this->inputs.front().event);
+        this->inputs.pop_front();
+        applied++;
+    }
+    if (applied > 0) {
+        PENDING_INPUTS.sub(applied);
+    }
+    return applied;
+}
+
+int SimulationLoop::advance(Clock::time_point now) {
+    if (!this->started) {
+        this->simulated = now;
+        this->started = true;
+    }
+
+    int ticks = 0;
+    int due = static_cast<int>((now - this->simulated) / this->tickDuration);
+
+    for (int i = 0; i < due; i++) {
+        Clock::time_point tickEnd = this->simulated + this->tickDuration;
+        if (this->applyInputs(tickEnd) > 0 && this->latencyProbe != nullptr) {
+            this->latencyProbe->recordInputs(tickEnd, Clock::now());
+        }
+
+        // Only the last tick's starting state is needed for interpolation
+        if (i == due - 1) {
+            this->previous = this->engine.getState();
+        }
+        this->engine.update(this->tickDelta);
+        this->simulated = tickEnd;
+        ticks++;
+
+        if (this->latencyProbe != nullptr) {
+            this->latencyProbe->recordTick(Clock::now());
+        }
+    }
+
+    // Inputs inside the tick in progress go in now rather than a tick late
+    if (this->applyInputs(now + Clock::duration(1)) > 0 && this->latencyProbe != nullptr) {
+        this->latencyProbe->recordInputs(now + Clock::duration(1), Clock::now());
+    }
+
+    this->alpha = std::chrono::duration<float>(now - this->simulated).count() / this->tickDelta;
+    return ticks;
+}
+
+void SimulationLoop::restart(Clock::time_point now) {
+    PENDING_INPUTS.sub(static_cast<int64_t>(this->inputs.size()));
+    this->inputs.clear();
+    this->simulated = now;
+    this->started = true;
+    this->previous = this->engine.getState();
+    this->alpha = 0.0f;
+}
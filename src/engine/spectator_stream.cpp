@@ -0,0 +1,498 @@
+#include "engine/spectator_stream.hpp"
+#include "engine/tetromino.hpp"
+#include <cstring>
+
+namespace {
+    constexpr int WIDTH = 10;
+    constexpr int HEIGHT = 20;
+    constexpr int CELLS = WIDTH * HEIGHT;
+
+    // More changed cells than this are cheaper to send as a packed board
+    constexpr int MAX_CELL_CHANGES = CELLS / 4;
+
+    // Well above the largest message (a delta with a packed board and every
+    // field is under 200 bytes); a longer length prefix is a corrupt stream
+    constexpr uint32_t MAX_MESSAGE_SIZE = 1024;
+
+    enum MessageType : uint8_t {
+        MSG_KEYFRAME = 1,
+        MSG_DELTA = 2
+    };
+
+    // Delta field mask
+    enum DeltaField : unsigned {
+        FIELD_PIECE = 1 << 0,
+        FIELD_GHOST = 1 << 1,
+        FIELD_CLEAR = 1 << 2,
+        FIELD_CELLS = 1 << 3,
+        FIELD_BOARD = 1 << 4,
+        FIELD_HOLD = 1 << 5,
+        FIELD_NEXT = 1 << 6,
+        FIELD_STATS = 1 << 7,
+        FIELD_FLAGS = 1 << 8
+    };
+
+    void putVarint(std::vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Zig-zag so small negative values (piece above the board) stay short
+    void putSigned(std::vector<uint8_t>& out, int value) {
+        putVarint(out, (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+    }
+
+    class Reader {
+    private:
+        const uint8_t* data;
+        std::size_t size;
+        std::size_t position;
+        bool failed;
+
+    public:
+        Reader(const uint8_t* data, std::size_t size)
+            : data(data), size(size), position(0), failed(false) {}
+
+        bool ok() const { return !failed && position == size; }
+        void fail() { failed = true; }
+
+        uint8_t byte() {
+            if (position >= size) {
+                failed = true;
+                return 0;
+            }
+            return data[position++];
+        }
+
+        uint32_t varint() {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                uint8_t b = byte();
+                value |= static_cast<uint32_t>(b & 0x7f) << shift;
+                if ((b & 0x80) == 0) {
+                    return value;
+                }
+            }
+            failed = true;
+            return 0;
+        }
+
+        int signedVarint() {
+            uint32_t value = varint();
+            return static_cast<int>((value >> 1) ^ (~(value & 1) + 1));
+        }
+    };
+
+    void putPiece(std::vector<uint8_t>& out, const GameState& state) {
+        out.push_back(static_cast<uint8_t>(static_cast<int>(state.currentPieceType) |
+                                           (static_cast<int>(state.currentPieceOrientation) << 4)));
+        putSigned(out, state.currentPieceX);
+        putSigned(out, state.currentPieceY);
+    }
+
+    void putHold(std::vector<uint8_t>& out, const GameState& state) {
+        out.push_back(static_cast<uint8_t>(static_cast<int>(state.heldPieceType) |
+                                           (state.hasHeldPiece ? 0x10 : 0) |
+                                           (state.canHold ? 0x20 : 0)));
+    }
+
+    void putNext(std::vector<uint8_t>& out, const GameState& state) {
+        out.push_back(static_cast<uint8_t>(static_cast<int>(state.nextPieces[0]) |
+                                           (static_cast<int>(state.nextPieces[1]) << 4)));
+    }
+
+    void putStats(std::vector<uint8_t>& out, const GameState& state) {
+        putVarint(out, static_cast<uint32_t>(state.score));
+        putVarint(out, static_cast<uint32_t>(state.level));
+        putVarint(out, static_cast<uint32_t>(state.linesCleared));
+        putVarint(out, static_cast<uint32_t>(state.piecesLocked));
+    }
+
+    // Bit 0 game over, bit 1 back-to-back, bit 2 perfect clear, bits 3-4 T-spin
+    void putFlags(std::vector<uint8_t>& out, const GameState& state) {
+        out.push_back(static_cast<uint8_t>((state.gameOver ? 0x01 : 0) |
+                                           (state.backToBack ? 0x02 : 0) |
+                                           (state.lastPerfectClear ? 0x04 : 0) |
+                                           (static_cast<int>(state.lastTSpin) << 3)));
+        putVarint(out, static_cast<uint32_t>(state.pendingGarbage));
+        putVarint(out, static_cast<uint32_t>(state.combo + 1));
+    }
+
+    void putBoard(std::vector<uint8_t>& out, const int board[HEIGHT][WIDTH]) {
+        const int* cells = &board[0][0];
+        for (int i = 0; i < CELLS; i += 2) {
+            out.push_back(static_cast<uint8_t>(cells[i] | (cells[i + 1] << 4)));
+        }
+    }
+
+    void readPiece(Reader& in, GameState& state) {
+        uint8_t packed = in.byte();
+        if ((packed & 0x0f) > static_cast<int>(TetrominoType::L)) {
+            in.fail();
+            packed = 0;
+        }
+        state.currentPieceType = static_cast<TetrominoType>(packed & 0x0f);
+        state.currentPieceOrientation = static_cast<Orientation>((packed >> 4) & 0x03);
+        state.currentPieceX = in.signedVarint();
+        state.currentPieceY = in.signedVarint();
+    }
+
+    void readHold(Reader& in, GameState& state) {
+        uint8_t packed = in.byte();
+        if ((packed & 0x0f) > static_cast<int>(TetrominoType::L)) {
+            in.fail();
+            packed = 0;
+        }
+        state.heldPieceType = static_cast<TetrominoType>(packed & 0x0f);
+        state.hasHeldPiece = (packed & 0x10) != 0;
+        state.canHold = (packed & 0x20) != 0;
+    }
+
+    void readNext(Reader& in, GameState& state) {
+        uint8_t packed = in.byte();
+        if ((packed & 0x0f) > static_cast<int>(TetrominoType::L) ||
+            (packed >> 4) > static_cast<int>(TetrominoType::L)) {
+            in.fail();
+            packed = 0;
+        }
+        state.nextPieces[0] = static_cast<TetrominoType>(packed & 0x0f);
+        state.nextPieces[1] = static_cast<TetrominoType>(packed >> 4);
+    }
+
+    void readStats(Reader& in, GameState& state) {
+        state.score = static_cast<int>(in.varint());
+        state.level = static_cast<int>(in.varint());
+        state.linesCleared = static_cast<int>(in.varint());
+        state.piecesLocked = static_cast<int>(in.varint());
+    }
+
+    void readFlags(Reader& in, GameState& state) {
+        uint8_t packed = in.byte();
+        if (((packed >> 3) & 0x03) > static_cast<int>(TSpinType::FULL)) {
+            in.fail();
+            packed = 0;
+        }
+        state.gameOver = (packed & 0x01) != 0;
+        state.backToBack = (packed & 0x02) != 0;
+        state.lastPerfectClear = (packed & 0x04) != 0;
+        state.lastTSpin = static_cast<TSpinType>((packed >> 3) & 0x03);
+        state.pendingGarbage = static_cast<int>(in.varint());
+        state.combo = static_cast<int>(in.varint()) - 1;
+    }
+
+    void readBoard(Reader& in, int board[HEIGHT][WIDTH]) {
+        int* cells = &board[0][0];
+        for (int i = 0; i < CELLS; i += 2) {
+            uint8_t packed = in.byte();
+            if ((packed & 0x0f) > static_cast<int>(TetrominoType::GARBAGE) ||
+                (packed >> 4) > static_cast<int>(TetrominoType::GARBAGE)) {
+                in.fail();
+                packed = 0;
+            }
+            cells[i] = packed & 0x0f;
+            cells[i + 1] = packed >> 4;
+        }
+    }
+
+    // Same compaction the engine does, applied to the spectator's copy
+    void removeRows(int board[HEIGHT][WIDTH], const int* rows, int count) {
+        for (int i = 0; i < count; i++) {
+            int shift = i + 1;
+            int runBottom = rows[i] - 1;
+            int runTop = (i + 1 < count) ? rows[i + 1] + 1 : 0;
+            int runLength = runBottom - runTop + 1;
+
+            if (runLength > 0) {
+                std::memmove(board[runTop + shift], board[runTop], sizeof(board[0]) * runLength);
+            }
+        }
+        std::memset(board[0], 0, sizeof(board[0]) * count);
+    }
+
+    // Wrap a finished message body with its length prefix
+    void finishMessage(std::vector<uint8_t>& out, std::size_t bodyStart) {
+        std::size_t bodySize = out.size() - bodyStart;
+        uint8_t prefix[5];
+        int prefixSize = 0;
+        uint32_t value = static_cast<uint32_t>(bodySize);
+        while (value >= 0x80) {
+            prefix[prefixSize++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        prefix[prefixSize++] = static_cast<uint8_t>(value);
+
+        out.insert(out.begin() + static_cast<std::ptrdiff_t>(bodyStart), prefix, prefix + prefixSize);
+    }
+}
+
+SpectatorEncoder::SpectatorEncoder() : hasPrevious(false) {
+    std::memset(&this->previous, 0, sizeof(this->previous));
+}
+
+void SpectatorEncoder::encodeKeyframe(const GameState& state, std::vector<uint8_t>& out) {
+    std::size_t start = out.size();
+
+    out.push_back(MSG_KEYFRAME);
+    putBoard(out, state.board);
+    putPiece(out, state);
+    putSigned(out, state.ghostPieceY);
+    putHold(out, state);
+    putNext(out, state);
+    putStats(out, state);
+    putFlags(out, state);
+
+    finishMessage(out, start);
+}
+
+void SpectatorEncoder::encode(const GameState& state, std::vector<uint8_t>& out) {
+    if (!this->hasPrevious) {
+        encodeKeyframe(state, out);
+        this->previous = state;
+        this->hasPrevious = true;
+        return;
+    }
+
+    const GameState& prev = this->previous;
+    unsigned mask = 0;
+
+    if (state.currentPieceType != prev.currentPieceType ||
+        state.currentPieceOrientation != prev.currentPieceOrientation ||
+        state.currentPieceX != prev.currentPieceX ||
+        state.currentPieceY != prev.currentPieceY) {
+        mask |= FIELD_PIECE;
+    }
+    if (state.ghostPieceY != prev.ghostPieceY) mask |= FIELD_GHOST;
+    if (state.heldPieceType != prev.heldPieceType || state.hasHeldPiece != prev.hasHeldPiece ||
+        state.canHold != prev.canHold) {
+        mask |= FIELD_HOLD;
+    }
+    if (state.nextPieces != prev.nextPieces) mask |= FIELD_NEXT;
+    if (state.score != prev.score || state.level != prev.level ||
+        state.linesCleared != prev.linesCleared || state.piecesLocked != prev.piecesLocked) {
+        mask |= FIELD_STATS;
+    }
+    if (state.gameOver != prev.gameOver || state.pendingGarbage != prev.pendingGarbage ||
+        state.lastTSpin != prev.lastTSpin || state.lastPerfectClear != prev.lastPerfectClear ||
+        state.combo != prev.combo || state.backToBack != prev.backToBack) {
+        mask |= FIELD_FLAGS;
+    }
+
+    // Board: replay the line clear on the old board, then list what is left
+    int board[HEIGHT][WIDTH];
+    std::memcpy(board, prev.board, sizeof(board));
+
+    bool cleared = state.linesCleared > prev.linesCleared && state.lastClearCount > 0;
+    if (cleared) {
+        removeRows(board, state.lastClearedRows.data(), state.lastClearCount);
+        mask |= FIELD_CLEAR;
+    }
+
+    uint8_t changes[CELLS];
+    int changeCount = 0;
+    const int* oldCells = &board[0][0];
+    const int* newCells = &state.board[0][0];
+
+    for (int i = 0; i < CELLS && changeCount <= MAX_CELL_CHANGES; i++) {
+        if (oldCells[i] != newCells[i]) {
+            changes[changeCount++] = static_cast<uint8_t>(i);
+        }
+    }
+
+    if (changeCount > MAX_CELL_CHANGES) {
+        mask = (mask & ~FIELD_CLEAR) | FIELD_BOARD;
+    } else if (changeCount > 0) {
+        mask |= FIELD_CELLS;
+    }
+
+    if (mask == 0) {
+        return;
+    }
+
+    std::size_t start = out.size();
+    out.push_back(MSG_DELTA);
+    putVarint(out, mask);
+
+    if (mask & FIELD_PIECE) putPiece(out, state);
+    if (mask & FIELD_GHOST) putSigned(out, state.ghostPieceY);
+
+    if (mask & FIELD_CLEAR) {
+        out.push_back(static_cast<uint8_t>(state.lastClearCount));
+        for (int i = 0; i < state.lastClearCount; i++) {
+            out.push_back(static_cast<uint8_t>(state.lastClearedRows[i]));
+        }
+    }
+
+    if (mask & FIELD_CELLS) {
+        putVarint(out, static_cast<uint32_t>(changeCount));
+        for (int i = 0; i < changeCount; i++) {
+            out.push_back(changes[i]);
+            out.push_back(static_cast<uint8_t>(newCells[changes[i]]));
+        }
+    }
+
+    if (mask & FIELD_BOARD) putBoard(out, state.board);
+    if (mask & FIELD_HOLD) putHold(out, state);
+    if (mask & FIELD_NEXT) putNext(out, state);
+    if (mask & FIELD_STATS) putStats(out, state);
+    if (mask & FIELD_FLAGS) putFlags(out, state);
+
+    finishMessage(out, start);
+    this->previous = state;
+}
+
+SpectatorDecoder::SpectatorDecoder() : hasKeyframe(false) {
+    std::memset(&this->state, 0, sizeof(this->state));
+}
+
+int SpectatorDecoder::feed(const uint8_t* data, std::size_t size) {
+    this->pending.insert(this->pending.end(), data, data + size);
+
+    int applied = 0;
+    std::size_t position = 0;
+
+    while (position < this->pending.size()) {
+        // Length prefix
+        uint32_t length = 0;
+        std::size_t cursor = position;
+        bool complete = false;
+
+        for (int shift = 0; shift < 35 && cursor < this->pending.size(); shift += 7) {
+            uint8_t b = this->pending[cursor++];
+            length |= static_cast<uint32_t>(b & 0x7f) << shift;
+            if ((b & 0x80) == 0) {
+                complete = true;
+                break;
+            }
+        }
+
+        // A prefix that runs past five bytes or announces an oversized message
+        // would otherwise leave feed() buffering forever
+        if ((!complete && cursor - position == 5) || length > MAX_MESSAGE_SIZE) {
+            this->pending.clear();
+            return -1;
+        }
+
+        if (!complete || this->pending.size() - cursor < length) {
+            break;
+        }
+
+        if (!this->applyMessage(this->pending.data() + cursor, length)) {
+            this->pending.clear();
+            return -1;
+        }
+
+        position = cursor + length;
+        applied++;
+    }
+
+    this->pending.erase(this->pending.begin(),
+                        this->pending.begin() + static_cast<std::ptrdiff_t>(position));
+    return applied;
+}
+
+bool SpectatorDecoder::applyMessage(const uint8_t* data, std::size_t size) {
+    Reader in(data, size);
+    GameState next = this->state;
+    bool cleared = false;
+
+    uint8_t type = in.byte();
+
+    if (type == MSG_KEYFRAME) {
+        readBoard(in, next.board);
+        readPiece(in, next);
+        next.ghostPieceY = in.signedVarint();
+        readHold(in, next);
+        readNext(in, next);
+        readStats(in, next);
+        readFlags(in, next);
+        next.lastClearCount = 0;
+    } else if (type == MSG_DELTA && this->hasKeyframe) {
+        unsigned mask = in.varint();
+
+        if (mask & FIELD_PIECE) readPiece(in, next);
+        if (mask & FIELD_GHOST) next.ghostPieceY = in.signedVarint();
+
+        if (mask & FIELD_CLEAR) {
+            int count = in.byte();
+            if (count < 1 || count > 4) return false;
+            // Bottom row first, all within the four rows one piece covers
+            for (int i = 0; i < count; i++) {
+                int row = in.byte();
+                if (row >= HEIGHT) return false;
+                if (i > 0 && (row >= next.lastClearedRows[i - 1] || next.lastClearedRows[0] - row >= 4)) {
+                    return false;
+                }
+                next.lastClearedRows[i] = row;
+            }
+            next.lastClearCount = count;
+            removeRows(next.board, next.lastClearedRows.data(), count);
+            cleared = true;
+        }
+
+        if (mask & FIELD_CELLS) {
+            uint32_t count = in.varint();
+            int* cells = &next.board[0][0];
+            for (uint32_t i = 0; i < count; i++) {
+                uint8_t index = in.byte();
+                uint8_t value = in.byte();
+                if (index >= CELLS || value > static_cast<int>(TetrominoType::GARBAGE)) return false;
+                cells[index] = value;
+            }
+        }
+
+        if (mask & FIELD_BOARD) readBoard(in, next.board);
+        if (mask & FIELD_HOLD) readHold(in, next);
+        if (mask & FIELD_NEXT) readNext(in, next);
+        if (mask & FIELD_STATS) readStats(in, next);
+        if (mask & FIELD_FLAGS) readFlags(in, next);
+    } else {
+        return false;
+    }
+
+    if (!in.ok()) {
+        return false;
+    }
+
+    if (type == MSG_DELTA) {
+        this->recordEvents(this->state, next, cleared);
+    }
+    this->state = next;
+    this->hasKeyframe = true;
+    return true;
+}
+
+void SpectatorDecoder::recordEvents(const GameState& previous, const GameState& next, bool cleared) {
+    auto push = [this](EngineEventType type, const GameState& from) -> EngineEvent& {
+        EngineEvent& event = this->events.push();
+        event = {type, from.currentPieceType, from.currentPieceOrientation,
+                 static_cast<int8_t>(from.currentPieceX), static_cast<int8_t>(from.currentPieceY), 0, 0};
+        return event;
+    };
+
+    if (next.piecesLocked != previous.piecesLocked) {
+        push(EngineEventType::PIECE_LOCKED, previous);
+    }
+    if (cleared) {
+        int lowest = next.lastClearedRows[0];
+        int rows = 0;
+        for (int i = 0; i < next.lastClearCount; i++) {
+            rows |= 1 << (lowest - next.lastClearedRows[i]);
+        }
+        EngineEvent& event = push(EngineEventType::LINES_CLEARED, previous);
+        event.y = static_cast<int8_t>(lowest);
+        event.detail = static_cast<int8_t>(next.lastClearCount);
+        event.value = static_cast<uint16_t>(rows);
+    }
+    if (next.level != previous.level) {
+        push(EngineEventType::LEVEL_CHANGED, next).value = static_cast<uint16_t>(next.level);
+    }
+    if (next.piecesLocked != previous.piecesLocked && !next.gameOver) {
+        push(EngineEventType::PIECE_SPAWNED, next);
+    }
+    if (next.gameOver && !previous.gameOver) {
+        push(EngineEventType::TOP_OUT, next);
+    }
+}
@@ -1,11 +1,182 @@
+#include "bot/agent_factory.hpp"
+#include "bot/agent_runner.hpp"
+#include "bot/book_agent.hpp"
 #include "engine/game.hpp"
+#include "engine/game_history.hpp"
+#include "engine/input_latency.hpp"
+#include "engine/replay.hpp"
+#include "engine/simulation_loop.hpp"
+#include "net/spectator_broadcast.hpp"
+#include "net/spectator_feed.hpp"
+#include "ui/grid_renderer.hpp"
 #include "ui/renderer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const char* broadcastPath = nullptr;
+    const char* watchPath = nullptr;
+    const char* botName = nullptr;
+    const char* bookPath = nullptr;
+    const char* recordPath = nullptr;
+    bool competitive = false;
+    bool latency = false;
+    int tickRate = SimulationLoop::DEFAULT_TICK_RATE;
+    int gridBoards = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--broadcast") == 0 && i + 1 < argc) {
+            broadcastPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--watch") == 0 && i + 1 < argc) {
+            watchPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--bot") == 0 && i + 1 < argc) {
+            botName = argv[++i];
+        } else if (std::strcmp(argv[i], "--book") == 0 && i + 1 < argc) {
+            bookPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--competitive") == 0) {
+            competitive = true;
+        } else if (std::strcmp(argv[i], "--latency") == 0) {
+            latency = true;
+        } else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            tickRate = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            gridBoards = std::atoi(argv[++i]);
+        }
+    }
 
-int main() {
     Game game;
-    Renderer renderer(game);
+    if (competitive) {
+        // Lock delay with move resets, 20G gravity from level 20
+        game.setRules(GameRules::competitive());
+    }
+    std::shared_ptr<OpeningBook> book;
+    if (bookPath != nullptr) {
+        book = std::make_shared<OpeningBook>();
+        if (!book->open(bookPath)) {
+            std::fprintf(stderr, "Cannot open opening book %s\n", bookPath);
+            return 1;
+        }
+    }
+
+    if (gridBoards > 0) {
+        // Many bot games side by side (heuristic unless --bot says otherwise)
+        std::vector<Game> games;
+        std::vector<IGameEngine*> engines;
+        std::vector<std::unique_ptr<IAgent>> agents;
+        std::vector<IAgent*> agentPointers;
+        games.reserve(gridBoards);
+
+        for (int i = 0; i < gridBoards; i++) {
+            games.emplace_back(game.getSeed() + static_cast<uint32_t>(i), game.getRules());
+            std::unique_ptr<IAgent> gridAgent =
+                AgentFactory::create(botName != nullptr ? botName : "heuristic", games.back().getSeed());
+            if (gridAgent == nullptr) {
+                std::fprintf(stderr, "Unknown bot %s\n", botName);
+                return 1;
+            }
+            if (book != nullptr) {
+                gridAgent = std::make_unique<BookAgent>(book, std::move(gridAgent));
+            }
+            agentPointers.push_back(gridAgent.get());
+            agents.push_back(std::move(gridAgent));
+        }
+        for (Game& gridGame : games) {
+            engines.push_back(&gridGame);
+        }
+
+        // Ten pieces a second per board, each decided with the agent's quickest search
+        GridRenderer grid(engines);
+        grid.attachAgents(agentPointers, AgentBudget(), 6);
+        grid.run();
+        return 0;
+    }
+
+    // History replays at the simulation rate, with a keyframe every second
+    HistoryConfig historyConfig;
+    historyConfig.tickDelta = 1.0f / static_cast<float>(tickRate);
+    historyConfig.keyframeInterval = tickRate;
+    GameHistory history(game, historyConfig);
+    IGameEngine* engine = &history;
+
+    std::unique_ptr<SpectatorFeed> feed;
+    std::unique_ptr<SpectatorBroadcast> broadcast;
+
+    if (watchPath != nullptr) {
+        // Watch a game running in another process
+        feed = std::make_unique<SpectatorFeed>();
+        if (!feed->open(watchPath)) {
+            std::fprintf(stderr, "Cannot open spectator stream %s\n", watchPath);
+            return 1;
+        }
+        engine = feed.get();
+    } else if (broadcastPath != nullptr) {
+        broadcast = std::make_unique<SpectatorBroadcast>(history);
+        if (!broadcast->listen(broadcastPath)) {
+            std::fprintf(stderr, "Cannot listen on %s\n", broadcastPath);
+            return 1;
+        }
+        engine = broadcast.get();
+    }
+
+    // Seed plus tick-stamped inputs, for tools/replay_export
+    std::unique_ptr<ReplayRecorder> recorder;
+    if (recordPath != nullptr && feed == nullptr) {
+        recorder = std::make_unique<ReplayRecorder>(*engine, game, tickRate);
+        engine = recorder.get();
+    }
+    auto saveRecording = [&]() {
+        if (recorder != nullptr && !recorder->getReplay().save(recordPath)) {
+            std::fprintf(stderr, "Cannot write replay %s\n", recordPath);
+            return 1;
+        }
+        return 0;
+    };
+
+    std::unique_ptr<IAgent> agent;
+    std::unique_ptr<AgentRunner> agentRunner;
+
+    if (botName != nullptr) {
+        agent = AgentFactory::create(botName, game.getSeed());
+        if (agent == nullptr) {
+            std::fprintf(stderr, "Unknown bot %s\n", botName);
+            return 1;
+        }
+        if (book != nullptr) {
+            agent = std::make_unique<BookAgent>(book, std::move(agent));
+        }
+        agentRunner = std::make_unique<AgentRunner>(*agent, 1.0f / 60.0f);
+    }
+
+    Renderer renderer(*engine);
+    renderer.setTickRate(tickRate);
+    if (feed == nullptr) {
+        renderer.attachHistory(&history);
+    }
+    if (agentRunner != nullptr) {
+        // Half a second of game time per piece
+        AgentBudget budget;
+        budget.ticks = 30;
+        renderer.attachAgent(agentRunner.get(), budget);
+    }
+
+    // Time every key press until it is on screen; the report prints on exit
+    std::unique_ptr<InputLatencyProbe> latencyProbe;
+    if (latency) {
+        latencyProbe = std::make_unique<InputLatencyProbe>(*engine);
+        renderer.attachLatencyProbe(latencyProbe.get());
+    }
 
     renderer.run();
 
-    return 0;
+    if (latencyProbe != nullptr) {
+        latencyProbe->report(stdout);
+    }
+
+    return saveRecording();
 }
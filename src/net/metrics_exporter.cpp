@@ -0,0 +1,139 @@
+#include "net/metrics_exporter.hpp"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+MetricsExporter::MetricsExporter(Metrics::Registry& registry)
+    : registry(registry), listenFd(-1), fileInterval(5.0f), stopping(false) {}
+
+MetricsExporter::~MetricsExporter() {
+    this->stop();
+    if (this->listenFd >= 0) {
+        close(this->listenFd);
+    }
+}
+
+bool MetricsExporter::listen(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, 16) != 0) {
+        close(fd);
+        return false;
+    }
+
+    this->listenFd = fd;
+    return true;
+}
+
+void MetricsExporter::setFile(const std::string& path, float intervalSeconds) {
+    this->filePath = path;
+    this->fileInterval = intervalSeconds > 0.0f ? intervalSeconds : 5.0f;
+}
+
+void MetricsExporter::start() {
+    if (this->worker.joinable() || (this->listenFd < 0 && this->filePath.empty())) {
+        return;
+    }
+    this->stopping = false;
+    this->worker = std::thread(&MetricsExporter::workerLoop, this);
+}
+
+void MetricsExporter::stop() {
+    if (!this->worker.joinable()) {
+        return;
+    }
+    this->stopping = true;
+    this->worker.join();
+
+    if (!this->filePath.empty()) {
+        this->writeFile(this->filePath);
+    }
+}
+
+bool MetricsExporter::writeFile(const std::string& path) const {
+    // Readers never see a half-written file
+    std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::string text = this->registry.writePrometheus();
+    bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    ok = std::fclose(file) == 0 && ok;
+    return ok && std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+void MetricsExporter::serveClient(int fd) {
+    // Any request gets the metrics; read (and ignore) what the client sent
+    char request[1024];
+    pollfd readable = {fd, POLLIN, 0};
+    if (poll(&readable, 1, 1000) > 0) {
+        ssize_t ignored = read(fd, request, sizeof(request));
+        (void)ignored;
+    }
+
+    std::string body = this->registry.writePrometheus();
+    char header[160];
+    int headerLength = std::snprintf(header, sizeof(header),
+                                     "HTTP/1.0 200 OK\r\n"
+                                     "Content-Type: text/plain; version=0.0.4\r\n"
+                                     "Content-Length: %zu\r\n"
+                                     "Connection: close\r\n\r\n",
+                                     body.size());
+
+    std::string response(header, static_cast<std::size_t>(headerLength));
+    response += body;
+
+    std::size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t written = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) break;
+        sent += static_cast<std::size_t>(written);
+    }
+    close(fd);
+}
+
+void MetricsExporter::workerLoop() {
+    using Clock = std::chrono::steady_clock;
+    auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(this->fileInterval));
+    auto nextWrite = Clock::now();
+
+    while (!this->stopping) {
+        if (!this->filePath.empty() && Clock::now() >= nextWrite) {
+            this->writeFile(this->filePath);
+            nextWrite = Clock::now() + interval;
+        }
+
+        // Wake at least every 100 ms to notice stop()
+        if (this->listenFd < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
+        pollfd listening = {this->listenFd, POLLIN, 0};
+        if (poll(&listening, 1, 100) > 0) {
+            int client = accept(this->listenFd, nullptr, nullptr);
+            if (client >= 0) {
+                this->serveClient(client);
+            }
+        }
+    }
+}
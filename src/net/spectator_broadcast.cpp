@@ -0,0 +1,221 @@
+#include "net/spectator_broadcast.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    constexpr int MAX_IOVECS = 64;
+
+    bool setNonBlocking(int fd) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+}
+
+SpectatorBroadcast::SpectatorBroadcast(IGameEngine& source)
+    : source(source), listenFd(-1), hasState(false) {
+    std::memset(&this->lastState, 0, sizeof(this->lastState));
+
+    // A pipe or FIFO reader that goes away must not kill the game; writev
+    // then fails with EPIPE and that subscriber is dropped
+    std::signal(SIGPIPE, SIG_IGN);
+}
+
+SpectatorBroadcast::~SpectatorBroadcast() {
+    for (Subscriber& subscriber : this->subscribers) {
+        close(subscriber.fd);
+    }
+
+    if (this->listenFd >= 0) {
+        close(this->listenFd);
+        unlink(this->socketPath.c_str());
+    }
+}
+
+void SpectatorBroadcast::update(float deltaTime) {
+    this->source.update(deltaTime);
+    this->publish(this->source.getState());
+}
+
+void SpectatorBroadcast::handleEvent(GameEvent event) {
+    this->source.handleEvent(event);
+}
+
+GameState SpectatorBroadcast::getState() const {
+    return this->source.getState();
+}
+
+int SpectatorBroadcast::readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const {
+    return this->source.readEvents(cursor, out, capacity);
+}
+
+uint64_t SpectatorBroadcast::getEventCursor() const {
+    return this->source.getEventCursor();
+}
+
+bool SpectatorBroadcast::listen(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 64) != 0 || !setNonBlocking(fd)) {
+        close(fd);
+        return false;
+    }
+
+    this->listenFd = fd;
+    this->socketPath = path;
+    return true;
+}
+
+void SpectatorBroadcast::addSubscriber(int fd) {
+    struct stat info;
+    bool isSocket = fstat(fd, &info) == 0 && S_ISSOCK(info.st_mode);
+
+    setNonBlocking(fd);
+
+    Subscriber subscriber{fd, isSocket, {}, 0};
+    if (this->hasState) {
+        // Late joiners start from a full snapshot
+        subscriber.queue.push_back(this->makeKeyframe());
+    }
+    this->subscribers.push_back(std::move(subscriber));
+}
+
+bool SpectatorBroadcast::addFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    this->addSubscriber(fd);
+    return true;
+}
+
+void SpectatorBroadcast::publish(const GameState& state) {
+    auto delta = std::make_shared<std::vector<uint8_t>>();
+    this->encoder.encode(state, *delta);
+
+    this->lastState = state;
+    this->hasState = true;
+
+    Chunk chunk = std::move(delta);
+    if (!chunk->empty()) {
+        for (Subscriber& subscriber : this->subscribers) {
+            subscriber.queue.push_back(chunk);
+        }
+    }
+
+    this->acceptSubscribers();
+
+    // Flush everyone, dropping subscribers that closed or fell too far behind
+    auto dropped = std::remove_if(this->subscribers.begin(), this->subscribers.end(),
+        [this](Subscriber& subscriber) {
+            if (!this->flushSubscriber(subscriber)) {
+                close(subscriber.fd);
+                return true;
+            }
+            return false;
+        });
+    this->subscribers.erase(dropped, this->subscribers.end());
+}
+
+SpectatorBroadcast::Chunk SpectatorBroadcast::makeKeyframe() const {
+    auto keyframe = std::make_shared<std::vector<uint8_t>>();
+    SpectatorEncoder::encodeKeyframe(this->lastState, *keyframe);
+    return keyframe;
+}
+
+void SpectatorBroadcast::acceptSubscribers() {
+    if (this->listenFd < 0) {
+        return;
+    }
+
+    // All watchers joining on the same tick share one keyframe
+    Chunk keyframe;
+
+    while (true) {
+        int fd = accept(this->listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            break;
+        }
+
+        setNonBlocking(fd);
+        if (!keyframe) {
+            keyframe = this->makeKeyframe();
+        }
+
+        Subscriber subscriber{fd, true, {}, 0};
+        subscriber.queue.push_back(keyframe);
+        this->subscribers.push_back(std::move(subscriber));
+    }
+}
+
+bool SpectatorBroadcast::flushSubscriber(Subscriber& subscriber) {
+    if (subscriber.queue.size() > MAX_QUEUED_CHUNKS) {
+        return false;
+    }
+
+    while (!subscriber.queue.empty()) {
+        iovec vectors[MAX_IOVECS];
+        int count = 0;
+
+        for (const Chunk& chunk : subscriber.queue) {
+            if (count == MAX_IOVECS) break;
+            std::size_t skip = (count == 0) ? subscriber.offset : 0;
+            vectors[count].iov_base = const_cast<uint8_t*>(chunk->data() + skip);
+            vectors[count].iov_len = chunk->size() - skip;
+            count++;
+        }
+
+        ssize_t written;
+        if (subscriber.isSocket) {
+            msghdr message;
+            std::memset(&message, 0, sizeof(message));
+            message.msg_iov = vectors;
+            message.msg_iovlen = static_cast<std::size_t>(count);
+            written = sendmsg(subscriber.fd, &message, MSG_NOSIGNAL);
+        } else {
+            written = writev(subscriber.fd, vectors, count);
+        }
+
+        // Anything else (EPIPE, ECONNRESET) means the subscriber is gone
+        if (written < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+
+        // Pop fully written chunks, remember how far into the next one we got
+        std::size_t remaining = static_cast<std::size_t>(written) + subscriber.offset;
+        while (!subscriber.queue.empty() && remaining >= subscriber.queue.front()->size()) {
+            remaining -= subscriber.queue.front()->size();
+            subscriber.queue.pop_front();
+        }
+        subscriber.offset = remaining;
+
+        if (remaining > 0) {
+            // Partial write: the descriptor is full for now
+            return true;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,91 @@
+#include "net/spectator_feed.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+SpectatorFeed::SpectatorFeed() : fd(-1), isSocket(false), connected(false) {}
+
+SpectatorFeed::~SpectatorFeed() {
+    if (this->fd >= 0) {
+        close(this->fd);
+    }
+}
+
+bool SpectatorFeed::open(const std::string& path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+
+    if (S_ISSOCK(info.st_mode)) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+
+        if (path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        this->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (this->fd < 0 ||
+            connect(this->fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            return false;
+        }
+        this->isSocket = true;
+    } else {
+        this->fd = ::open(path.c_str(), O_RDONLY);
+        if (this->fd < 0) {
+            return false;
+        }
+    }
+
+    fcntl(this->fd, F_SETFL, fcntl(this->fd, F_GETFL, 0) | O_NONBLOCK);
+    this->connected = true;
+    return true;
+}
+
+void SpectatorFeed::update(float) {
+    if (!this->connected) {
+        return;
+    }
+
+    uint8_t buffer[4096];
+
+    while (true) {
+        ssize_t length = read(this->fd, buffer, sizeof(buffer));
+
+        if (length > 0) {
+            if (this->decoder.feed(buffer, static_cast<std::size_t>(length)) < 0) {
+                this->connected = false;
+                return;
+            }
+        } else {
+            // A closed socket ends the feed; a file may still be growing
+            if (length == 0 && this->isSocket) {
+                this->connected = false;
+            }
+            return;
+        }
+    }
+}
+
+void SpectatorFeed::handleEvent(GameEvent) {
+    // Spectators cannot play
+}
+
+GameState SpectatorFeed::getState() const {
+    return this->decoder.getState();
+}
+
+int SpectatorFeed::readEvents(uint64_t& cursor, EngineEvent* out, int capacity) const {
+    return this->decoder.readEvents(cursor, out, capacity);
+}
+
+uint64_t SpectatorFeed::getEventCursor() const {
+    return this->decoder.getEventCursor();
+}
@@ -0,0 +1,226 @@
+#include "ui/grid_renderer.hpp"
+#include "engine/tetromino.hpp"
+#include "raylib.h"
+#include <algorithm>
+
+namespace {
+    const Color BACKGROUND = {20, 20, 20, 255};
+
+    // Same colors as Renderer::getColorForType, indexed by TetrominoType
+    const Color PIECE_COLORS[9] = {
+        {20, 20, 20, 255},      // empty
+        {0, 255, 255, 255},     // I
+        {255, 255, 0, 255},     // O
+        {128, 0, 128, 255},     // T
+        {0, 255, 0, 255},       // S
+        {255, 0, 0, 255},       // Z
+        {0, 0, 255, 255},       // J
+        {255, 165, 0, 255},     // L
+        {128, 128, 128, 255}    // garbage
+    };
+
+    // The texture has no blending per texel, so fades are mixed in here
+    Color blend(Color color, Color over, float amount) {
+        auto mix = [amount](unsigned char a, unsigned char b) {
+            return static_cast<unsigned char>(a + (b - a) * amount);
+        };
+        return {mix(color.r, over.r), mix(color.g, over.g), mix(color.b, over.b), 255};
+    }
+}
+
+GridRenderer::GridRenderer(const std::vector<IGameEngine*>& engines, int width, int height)
+    : engines(engines), screenWidth(width), screenHeight(height), tickAccumulator(0.0f),
+      ticksPerPiece(1) {
+
+    InitWindow(this->screenWidth, this->screenHeight, "Tetris - spectator grid");
+    SetTargetFPS(60);
+
+    this->computeLayout();
+
+    int textureWidth = this->columns * TILE_WIDTH;
+    int textureHeight = this->rows * TILE_HEIGHT;
+    this->pixels.assign(textureWidth * textureHeight, BLACK);
+
+    Image image = GenImageColor(textureWidth, textureHeight, BLACK);
+    this->texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    SetTextureFilter(this->texture, TEXTURE_FILTER_POINT);
+}
+
+GridRenderer::~GridRenderer() {
+    UnloadTexture(this->texture);
+    CloseWindow();
+}
+
+void GridRenderer::computeLayout() {
+    int count = std::max(1, static_cast<int>(this->engines.size()));
+    int availableHeight = this->screenHeight - HEADER_HEIGHT;
+
+    // Try every column count and keep the one with the biggest whole-pixel cells
+    this->columns = 1;
+    this->rows = count;
+    this->cellSize = 0;
+
+    for (int columns = 1; columns <= count; columns++) {
+        int rows = (count + columns - 1) / columns;
+        int cell = std::min(this->screenWidth / (columns * TILE_WIDTH), availableHeight / (rows * TILE_HEIGHT));
+        if (cell > this->cellSize) {
+            this->columns = columns;
+            this->rows = rows;
+            this->cellSize = cell;
+        }
+    }
+    this->cellSize = std::max(1, this->cellSize);
+
+    this->originX = (this->screenWidth - this->columns * TILE_WIDTH * this->cellSize) / 2;
+    this->originY = HEADER_HEIGHT;
+}
+
+void GridRenderer::attachAgents(const std::vector<IAgent*>& agents, const AgentBudget& budget, int ticksPerPiece) {
+    this->agents = agents;
+    this->agents.resize(this->engines.size(), nullptr);
+    this->agentBudget = budget;
+    this->ticksPerPiece = std::max(1, ticksPerPiece);
+    this->agentPieces.assign(this->engines.size(), -1);
+    this->agentWait.assign(this->engines.size(), 0);
+    this->events.reserve(16);
+}
+
+void GridRenderer::driveAgents() {
+    for (std::size_t i = 0; i < this->agents.size(); i++) {
+        IAgent* agent = this->agents[i];
+        if (agent == nullptr) continue;
+
+        if (this->agentWait[i] > 0) {
+            this->agentWait[i]--;
+            continue;
+        }
+
+        GameState state = this->engines[i]->getState();
+        if (state.gameOver || state.piecesLocked == this->agentPieces[i]) continue;
+
+        Deadline deadline(this->agentBudget, TARGET_TICK_RATE);
+        this->plan.clear();
+        agent->think(state, deadline, this->plan);
+
+        if (this->plan.take(this->events)) {
+            for (GameEvent event : this->events) {
+                this->engines[i]->handleEvent(event);
+            }
+        }
+        this->agentPieces[i] = state.piecesLocked;
+        this->agentWait[i] = this->ticksPerPiece - 1;
+    }
+}
+
+void GridRenderer::writeBoard(int index, const GameState& state) {
+    int stride = this->columns * TILE_WIDTH;
+    Color* tile = this->pixels.data() + (index / this->columns) * TILE_HEIGHT * stride +
+                  (index % this->columns) * TILE_WIDTH;
+
+    // Finished games are drawn faded
+    float fade = state.gameOver ? 0.6f : 0.0f;
+
+    for (int row = 0; row < 20; row++) {
+        Color* line = tile + row * stride;
+        for (int col = 0; col < 10; col++) {
+            line[col] = PIECE_COLORS[state.board[row][col]];
+            if (fade > 0.0f) {
+                line[col] = blend(line[col], BLACK, fade);
+            }
+        }
+    }
+
+    if (state.gameOver || state.currentPieceType == TetrominoType::NONE) {
+        return;
+    }
+
+    const PieceShape& shape = Tetromino::getShape(state.currentPieceType, state.currentPieceOrientation);
+    Color color = PIECE_COLORS[static_cast<int>(state.currentPieceType)];
+    Color ghost = blend(color, BACKGROUND, 0.7f);
+
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (!shape.isFilled(row, col)) continue;
+
+            int x = state.currentPieceX + col;
+            if (x < 0 || x >= 10) continue;
+
+            int ghostY = state.ghostPieceY + row;
+            if (ghostY >= 0 && ghostY < 20 && state.board[ghostY][x] == 0) {
+                tile[ghostY * stride + x] = ghost;
+            }
+            int y = state.currentPieceY + row;
+            if (y >= 0 && y < 20) {
+                tile[y * stride + x] = color;
+            }
+        }
+    }
+}
+
+void GridRenderer::drawLabels(const std::vector<GameState>& states) {
+    if (this->cellSize < LABEL_MIN_CELL) {
+        return;
+    }
+
+    int fontSize = std::min(20, this->cellSize);
+    for (std::size_t i = 0; i < states.size(); i++) {
+        int x = this->originX + static_cast<int>(i % this->columns) * TILE_WIDTH * this->cellSize;
+        int y = this->originY + static_cast<int>(i / this->columns) * TILE_HEIGHT * this->cellSize;
+        DrawText(TextFormat("#%d %d", static_cast<int>(i) + 1, states[i].score), x + 2, y + 2, fontSize, WHITE);
+    }
+}
+
+void GridRenderer::run() {
+    std::vector<GameState> states(this->engines.size());
+
+    while (!WindowShouldClose()) {
+        float frameTime = GetFrameTime();
+
+        if (IsKeyPressed(KEY_R)) {
+            for (IGameEngine* engine : this->engines) {
+                engine->handleEvent(GameEvent::RESTART);
+            }
+            std::fill(this->agentPieces.begin(), this->agentPieces.end(), -1);
+        }
+
+        // Fixed timestep update (60 ticks per second) for every board
+        this->tickAccumulator += frameTime;
+        while (this->tickAccumulator >= TARGET_TICK_RATE) {
+            this->driveAgents();
+            for (IGameEngine* engine : this->engines) {
+                engine->update(TARGET_TICK_RATE);
+            }
+            this->tickAccumulator -= TARGET_TICK_RATE;
+        }
+
+        // All boards go into the cell texture, uploaded once
+        int alive = 0;
+        int best = 0;
+        for (std::size_t i = 0; i < this->engines.size(); i++) {
+            states[i] = this->engines[i]->getState();
+            this->writeBoard(static_cast<int>(i), states[i]);
+            alive += states[i].gameOver ? 0 : 1;
+            best = std::max(best, states[i].score);
+        }
+        UpdateTexture(this->texture, this->pixels.data());
+
+        BeginDrawing();
+        ClearBackground(BLACK);
+
+        Rectangle source = {0.0f, 0.0f, static_cast<float>(this->texture.width),
+                            static_cast<float>(this->texture.height)};
+        Rectangle destination = {static_cast<float>(this->originX), static_cast<float>(this->originY),
+                                 static_cast<float>(this->texture.width * this->cellSize),
+                                 static_cast<float>(this->texture.height * this->cellSize)};
+        DrawTexturePro(this->texture, source, destination, {0.0f, 0.0f}, 0.0f, WHITE);
+
+        this->drawLabels(states);
+
+        DrawText(TextFormat("%d BOARDS  ALIVE: %d  BEST: %d", static_cast<int>(this->engines.size()), alive, best),
+                 10, 6, 20, WHITE);
+        DrawFPS(this->screenWidth - 90, 6);
+
+        EndDrawing();
+    }
+}
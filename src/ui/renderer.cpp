@@ -2,33 +2,46 @@
 #include "engine/igame_engine.hpp"
 #include "engine/tetromino.hpp"
 #include "raylib.h"
+#include <algorithm>
 #include <cstring>
 
-Renderer::Renderer(IGameEngine& game, int width, int height, int cellSize)
-    : gameEngine(game), screenWidth(width), screenHeight(height),
-      cellSize(cellSize), tickAccumulator(0.0f) {
-
-    // Calculate layout
-    this->boardOffsetX = 250;
-    this->boardOffsetY = 50;
-
-    this->holdBoxX = 50;
-    this->holdBoxY = 50;
+namespace {
+    Color toColor(Rgba color) {
+        return {color.r, color.g, color.b, color.a};
+    }
+}
 
-    this->nextBoxX = this->boardOffsetX + (10 * this->cellSize) + 50;
-    this->nextBoxY = 50;
+Renderer::Renderer(IGameEngine& game, int width, int height, int cellSize)
+    : gameEngine(game), layout(width, height, cellSize), simulation(game) {
 
     // Initialize window
-    InitWindow(this->screenWidth, this->screenHeight, "Tetris");
+    InitWindow(this->layout.width, this->layout.height, "Tetris");
     SetTargetFPS(60);
 
+    // Text that never changes is rasterized once
+    this->staticLayer = LoadRenderTexture(this->layout.width, this->layout.height);
+    this->statsLayer = LoadRenderTexture(this->layout.width - this->layout.nextX, STATS_LAYER_HEIGHT);
+    this->gameOverLayer = LoadRenderTexture(this->layout.width, this->layout.height);
+    this->buildStaticLayer();
+    this->buildGameOverLayer();
+
+    this->eventCursor = this->gameEngine.getEventCursor();
     this->setupDefaultKeyMapping();
 }
 
 Renderer::~Renderer() {
+    UnloadRenderTexture(this->staticLayer);
+    UnloadRenderTexture(this->statsLayer);
+    UnloadRenderTexture(this->gameOverLayer);
     CloseWindow();
 }
 
+bool Renderer::HudValues::operator==(const HudValues& other) const {
+    return score == other.score && level == other.level && linesCleared == other.linesCleared &&
+           lastTSpin == other.lastTSpin && lastPerfectClear == other.lastPerfectClear &&
+           backToBack == other.backToBack && combo == other.combo;
+}
+
 void Renderer::setupDefaultKeyMapping() {
     this->mapKey(KEY_LEFT, GameEvent::MOVE_LEFT);
     this->mapKey(KEY_H, GameEvent::MOVE_LEFT);
@@ -58,99 +71,208 @@ void Renderer::clearKeyMapping() {
     this->keyMapping.clear();
 }
 
+void Renderer::attachHistory(GameHistory* history) {
+    this->history = history;
+    this->scrubbing = false;
+}
+
+void Renderer::attachAgent(AgentRunner* runner, const AgentBudget& budget) {
+    this->agentRunner = runner;
+    this->agentBudget = budget;
+    this->agentPiece = -1;
+}
+
+void Renderer::attachLatencyProbe(InputLatencyProbe* probe) {
+    this->latencyProbe = probe;
+    this->simulation.attachLatencyProbe(probe);
+}
+
+void Renderer::setTickRate(int ticksPerSecond) {
+    this->simulation.setTickRate(ticksPerSecond);
+}
+
 void Renderer::run() {
     while (!WindowShouldClose()) {
         float frameTime = GetFrameTime();
 
-        this->processInput();
+        if (this->history != nullptr) {
+            this->processScrubInput();
+        }
+
+        if (!this->scrubbing) {
+            this->processInput();
+
+            if (this->agentRunner != nullptr) {
+                this->driveAgent();
+            }
 
-        // Fixed timestep update (60 ticks per second)
-        this->tickAccumulator += frameTime;
-        while (this->tickAccumulator >= TARGET_TICK_RATE) {
-            this->gameEngine.update(TARGET_TICK_RATE);
-            this->tickAccumulator -= TARGET_TICK_RATE;
+            // Fixed-rate ticks up to now, each applying the inputs stamped inside it
+            this->simulation.advance(SimulationLoop::Clock::now());
         }
 
         // Render
         BeginDrawing();
         ClearBackground(BLACK);
 
-        GameState state = this->gameEngine.getState();
+        GameState state = this->scrubbing
+            ? this->history->getStateAt(this->scrubTick)
+            : this->gameEngine.getState();
+        if (!this->scrubbing) {
+            this->processEngineEvents();
+        }
+        this->updateClearFlash(frameTime);
 
+        this->drawLayer(this->staticLayer, 0, 0);
         this->drawBoard(state);
         this->drawGhostPiece(state);
-        this->drawTetromino(state);
-        this->drawHoldBox(state);
-        this->drawNextBox(state);
+        float pieceX = static_cast<float>(state.currentPieceX);
+        float pieceY = static_cast<float>(state.currentPieceY);
+        if (!this->scrubbing) {
+            this->interpolatePiece(state, pieceX, pieceY);
+        }
+        this->drawTetromino(state, pieceX, pieceY);
+        this->drawClearFlash();
+        this->drawHoldPiece(state);
+        this->drawNextPieces(state);
+        this->drawGarbageMeter(state);
         this->drawUI(state);
 
         if (state.gameOver) {
             this->drawGameOver();
         }
 
+        if (this->scrubbing) {
+            this->drawScrubBar();
+        }
+
         EndDrawing();
+
+        if (this->latencyProbe != nullptr && !this->scrubbing) {
+            this->latencyProbe->recordFrame(InputLatencyProbe::Clock::now());
+        }
     }
 }
 
 void Renderer::processInput() {
-    float keyDelay = 0.15f;
-    float interval = 0.05f;
+    const auto keyDelay = std::chrono::milliseconds(200);
+    const auto interval = std::chrono::milliseconds(50);
+
+    // Raylib has no event timestamps, so presses are timed from this poll;
+    // auto-repeats fall at their exact times between polls
+    auto now = SimulationLoop::Clock::now();
 
     for (const auto& [key, event] : this->keyMapping) {
+        bool repeats = event == GameEvent::MOVE_LEFT || event == GameEvent::MOVE_RIGHT ||
+                       event == GameEvent::MOVE_DOWN;
+
         if (IsKeyPressed(key)) {
-            this->gameEngine.handleEvent(event);
-            this->moveTimer = 0;
+            this->pushInput(event, now);
+            if (repeats) {
+                this->repeatKey = key;
+                this->nextRepeat = now + keyDelay;
+            }
         }
 
-        if (IsKeyDown(key)) {
-            if (event == GameEvent::MOVE_LEFT || event == GameEvent::MOVE_RIGHT || event == GameEvent::MOVE_DOWN) {
-                this->moveTimer += TARGET_TICK_RATE;
-                if (this->moveTimer > keyDelay + interval) {
-                    this->gameEngine.handleEvent(event);
-                    this->moveTimer = keyDelay;
-                }
+        if (key == this->repeatKey) {
+            if (!IsKeyDown(key)) {
+                this->repeatKey = 0;
+                continue;
+            }
+            while (this->nextRepeat <= now) {
+                this->pushInput(event, this->nextRepeat);
+                this->nextRepeat += interval;
             }
         }
     }
 }
 
-Color Renderer::getColorForType(TetrominoType type) const {
-    switch (type) {
-        case TetrominoType::I: return {0, 255, 255, 255};    // Cyan
-        case TetrominoType::O: return {255, 255, 0, 255};    // Yellow
-        case TetrominoType::T: return {128, 0, 128, 255};    // Purple
-        case TetrominoType::S: return {0, 255, 0, 255};      // Green
-        case TetrominoType::Z: return {255, 0, 0, 255};      // Red
-        case TetrominoType::J: return {0, 0, 255, 255};      // Blue
-        case TetrominoType::L: return {255, 165, 0, 255};    // Orange
-        default: return {128, 128, 128, 255};                // Gray
+void Renderer::pushInput(GameEvent event, SimulationLoop::Clock::time_point time) {
+    if (this->latencyProbe != nullptr) {
+        this->latencyProbe->recordKey(event, time);
+    }
+    this->simulation.push(event, time);
+}
+
+void Renderer::driveAgent() {
+    // Apply a finished plan as soon as it is available
+    if (this->agentRunner->poll(this->agentEvents)) {
+        auto now = SimulationLoop::Clock::now();
+        for (GameEvent event : this->agentEvents) {
+            this->simulation.push(event, now);
+        }
+    }
+
+    if (this->agentRunner->isWaiting()) {
+        return;
+    }
+
+    GameState state = this->gameEngine.getState();
+    if (state.gameOver) {
+        this->agentPiece = -1;
+        return;
+    }
+
+    // One request per piece; a busy (overrunning) agent is retried next frame
+    if (state.piecesLocked != this->agentPiece &&
+        this->agentRunner->request(state, this->agentBudget)) {
+        this->agentPiece = state.piecesLocked;
+    }
+}
+
+void Renderer::processScrubInput() {
+    if (IsKeyPressed(KEY_P)) {
+        this->scrubbing = !this->scrubbing;
+        this->scrubTick = this->history->getCurrentTick();
+        this->simulation.restart(SimulationLoop::Clock::now());
+    }
+
+    if (!this->scrubbing) {
+        return;
+    }
+
+    int step = 0;
+    if (IsKeyPressed(KEY_LEFT_BRACKET) || IsKeyPressedRepeat(KEY_LEFT_BRACKET)) step = -1;
+    if (IsKeyPressed(KEY_RIGHT_BRACKET) || IsKeyPressedRepeat(KEY_RIGHT_BRACKET)) step = 1;
+    if (IsKeyPressed(KEY_PAGE_UP)) step = -this->simulation.getTickRate();
+    if (IsKeyPressed(KEY_PAGE_DOWN)) step = this->simulation.getTickRate();
+
+    this->scrubTick += step;
+    if (this->scrubTick < this->history->getOldestTick()) {
+        this->scrubTick = this->history->getOldestTick();
+    }
+    if (this->scrubTick > this->history->getCurrentTick()) {
+        this->scrubTick = this->history->getCurrentTick();
     }
 }
 
+Color Renderer::getColorForType(TetrominoType type) const {
+    return toColor(ScreenLayout::pieceColor(type));
+}
+
 void Renderer::drawCell(int gridX, int gridY, TetrominoType type, float alpha) {
     Color color = this->getColorForType(type);
     color.a = static_cast<unsigned char>(255 * alpha);
 
-    int x = this->boardOffsetX + gridX * this->cellSize;
-    int y = this->boardOffsetY + gridY * this->cellSize;
+    int x = this->layout.boardX + gridX * this->layout.cellSize;
+    int y = this->layout.boardY + gridY * this->layout.cellSize;
 
-    DrawRectangle(x + 1, y + 1, this->cellSize - 2, this->cellSize - 2, color);
-    DrawRectangleLines(x, y, this->cellSize, this->cellSize, WHITE);
+    DrawRectangle(x + 1, y + 1, this->layout.cellSize - 2, this->layout.cellSize - 2, color);
+    DrawRectangleLines(x, y, this->layout.cellSize, this->layout.cellSize, WHITE);
 }
 
-void Renderer::drawPieceShape(const int shape[4][4], int offsetX, int offsetY,
+void Renderer::drawPieceShape(const PieceShape& shape, int offsetX, int offsetY,
                                TetrominoType type, float alpha) {
-    for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-            if (shape[row][col] != 0) {
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (shape.isFilled(row, col)) {
                 Color color = this->getColorForType(type);
                 color.a = static_cast<unsigned char>(255 * alpha);
 
-                int x = offsetX + col * this->cellSize;
-                int y = offsetY + row * this->cellSize;
+                int x = offsetX + col * this->layout.cellSize;
+                int y = offsetY + row * this->layout.cellSize;
 
-                DrawRectangle(x + 1, y + 1, this->cellSize - 2, this->cellSize - 2, color);
-                DrawRectangleLines(x, y, this->cellSize, this->cellSize, WHITE);
+                DrawRectangle(x + 1, y + 1, this->layout.cellSize - 2, this->layout.cellSize - 2, color);
+                DrawRectangleLines(x, y, this->layout.cellSize, this->layout.cellSize, WHITE);
             }
         }
     }
@@ -158,17 +280,17 @@ void Renderer::drawPieceShape(const int shape[4][4], int offsetX, int offsetY,
 
 void Renderer::drawBoard(const GameState& state) {
     // Draw board background
-    DrawRectangle(this->boardOffsetX, this->boardOffsetY,
-                  10 * this->cellSize, 20 * this->cellSize,
-                  {20, 20, 20, 255});
+    DrawRectangle(this->layout.boardX, this->layout.boardY,
+                  10 * this->layout.cellSize, 20 * this->layout.cellSize,
+                  toColor(ScreenLayout::PANEL));
 
     // Draw grid and locked pieces
     for (int row = 0; row < 20; row++) {
         for (int col = 0; col < 10; col++) {
-            int x = this->boardOffsetX + col * this->cellSize;
-            int y = this->boardOffsetY + row * this->cellSize;
+            int x = this->layout.boardX + col * this->layout.cellSize;
+            int y = this->layout.boardY + row * this->layout.cellSize;
 
-            DrawRectangleLines(x, y, this->cellSize, this->cellSize, {50, 50, 50, 255});
+            DrawRectangleLines(x, y, this->layout.cellSize, this->layout.cellSize, toColor(ScreenLayout::GRID));
 
             if (state.board[row][col] != 0) {
                 TetrominoType type = static_cast<TetrominoType>(state.board[row][col]);
@@ -178,25 +300,34 @@ void Renderer::drawBoard(const GameState& state) {
     }
 }
 
-void Renderer::drawTetromino(const GameState& state) {
-    for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-            if (state.currentPieceShape[row][col] != 0) {
-                this->drawCell(
-                    state.currentPieceX + col,
-                    state.currentPieceY + row,
-                    state.currentPieceType,
-                    1.0f
-                );
-            }
-        }
+void Renderer::drawTetromino(const GameState& state, float pieceX, float pieceY) {
+    const PieceShape& shape = Tetromino::getShape(state.currentPieceType, state.currentPieceOrientation);
+
+    int offsetX = this->layout.boardX + static_cast<int>(pieceX * this->layout.cellSize + 0.5f);
+    int offsetY = this->layout.boardY + static_cast<int>(pieceY * this->layout.cellSize + 0.5f);
+    this->drawPieceShape(shape, offsetX, offsetY, state.currentPieceType);
+}
+
+void Renderer::interpolatePiece(const GameState& state, float& pieceX, float& pieceY) const {
+    // Only the same piece in the same orientation slides; anything else snaps
+    const GameState& previous = this->simulation.getPreviousState();
+    if (state.gameOver || previous.piecesLocked != state.piecesLocked || previous.canHold != state.canHold ||
+        previous.currentPieceType != state.currentPieceType ||
+        previous.currentPieceOrientation != state.currentPieceOrientation) {
+        return;
     }
+
+    float alpha = std::min(1.0f, this->simulation.getAlpha());
+    pieceX = previous.currentPieceX + (state.currentPieceX - previous.currentPieceX) * alpha;
+    pieceY = previous.currentPieceY + (state.currentPieceY - previous.currentPieceY) * alpha;
 }
 
 void Renderer::drawGhostPiece(const GameState& state) {
-    for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-            if (state.currentPieceShape[row][col] != 0) {
+    const PieceShape& shape = Tetromino::getShape(state.currentPieceType, state.currentPieceOrientation);
+
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (shape.isFilled(row, col)) {
                 this->drawCell(
                     state.currentPieceX + col,
                     state.ghostPieceY + row,
@@ -211,90 +342,131 @@ void Renderer::drawGhostPiece(const GameState& state) {
 void Renderer::drawCenteredPiece(TetrominoType type, int boxX, int boxY, int boxSize, float alpha) {
     if (type == TetrominoType::NONE) return;
 
-    int shape[4][4];
-    Tetromino::getBaseShape(type, Orientation::NORTH, shape);
-
-    // Find real tetromino dimensions
-    int minCol = 4, maxCol = 0, minRow = 4, maxRow = 0;
-    bool hasContent = false;
-    for (int r = 0; r < 4; r++) {
-        for (int c = 0; c < 4; c++) {
-            if (shape[r][c] != 0) {
-                if (c < minCol) minCol = c;
-                if (c > maxCol) maxCol = c;
-                if (r < minRow) minRow = r;
-                if (r > maxRow) maxRow = r;
-                hasContent = true;
-            }
-        }
-    }
-
-    if (!hasContent) return;
+    const PieceShape& shape = Tetromino::getShape(type, Orientation::NORTH);
+    if (shape.mask == 0) return;
 
-    int pieceWidth = (maxCol - minCol + 1) * this->cellSize;
-    int pieceHeight = (maxRow - minRow + 1) * this->cellSize;
+    int pieceWidth = (shape.maxCol - shape.minCol + 1) * this->layout.cellSize;
+    int pieceHeight = (shape.maxRow - shape.minRow + 1) * this->layout.cellSize;
 
-    int centeredX = boxX + (boxSize - pieceWidth) / 2 - (minCol * this->cellSize);
-    int centeredY = boxY + (boxSize - pieceHeight) / 2 - (minRow * this->cellSize);
+    int centeredX = boxX + (boxSize - pieceWidth) / 2 - (shape.minCol * this->layout.cellSize);
+    int centeredY = boxY + (boxSize - pieceHeight) / 2 - (shape.minRow * this->layout.cellSize);
 
     this->drawPieceShape(shape, centeredX, centeredY, type, alpha);
 }
 
-void Renderer::drawHoldBox(const GameState& state) {
-    DrawText("HOLD", this->holdBoxX, this->holdBoxY - 25, 20, WHITE);
-
-    int boxSize = 4 * this->cellSize;
-    DrawRectangle(this->holdBoxX, this->holdBoxY, boxSize, boxSize, {20, 20, 20, 255});
-    DrawRectangleLines(this->holdBoxX, this->holdBoxY, boxSize, boxSize, WHITE);
-
+void Renderer::drawHoldPiece(const GameState& state) {
     if (state.hasHeldPiece) {
         float alpha = state.canHold ? 1.0f : 0.4f;
-        this->drawCenteredPiece(state.heldPieceType, this->holdBoxX, this->holdBoxY, boxSize, alpha);
+        this->drawCenteredPiece(state.heldPieceType, this->layout.holdX, this->layout.holdY, this->layout.boxSize, alpha);
     }
 }
 
-void Renderer::drawNextBox(const GameState& state) {
-DrawText("NEXT", this->nextBoxX, this->nextBoxY - 25, 20, WHITE);
+void Renderer::drawNextPieces(const GameState& state) {
+    int boxSize = this->layout.boxSize;
+    int yOffset = this->layout.nextY;
 
-    int boxSize = 4 * this->cellSize;
-    int yOffset = this->nextBoxY;
+    for (int i = 0; i < ScreenLayout::NEXT_COUNT; i++) {
+        if (state.nextPieces[i] != TetrominoType::NONE) {
+            this->drawCenteredPiece(state.nextPieces[i], this->layout.nextX, yOffset, boxSize, 1.0f);
+        }
+        yOffset += boxSize + ScreenLayout::NEXT_SPACING;
+    }
+}
 
-    for (int i = 0; i < 2; i++) {
-        DrawRectangle(this->nextBoxX, yOffset, boxSize, boxSize, {20, 20, 20, 255});
-        DrawRectangleLines(this->nextBoxX, yOffset, boxSize, boxSize, WHITE);
+void Renderer::drawGarbageMeter(const GameState& state) {
+    if (state.pendingGarbage <= 0) return;
 
-        if (state.nextPieces[i] != TetrominoType::NONE) {
-            this->drawCenteredPiece(state.nextPieces[i], this->nextBoxX, yOffset, boxSize, 1.0f);
+    // Red bar along the left edge of the board, one cell per incoming line
+    int lines = state.pendingGarbage < 20 ? state.pendingGarbage : 20;
+    int height = lines * this->layout.cellSize;
+    int x = this->layout.boardX - 8;
+    int y = this->layout.boardY + 20 * this->layout.cellSize - height;
+
+    DrawRectangle(x, y, 6, height, RED);
+}
+
+void Renderer::processEngineEvents() {
+    EngineEvent events[16];
+    int count;
+
+    while ((count = this->gameEngine.readEvents(this->eventCursor, events, 16)) > 0) {
+        for (int i = 0; i < count; i++) {
+            const EngineEvent& event = events[i];
+            if (event.type != EngineEventType::LINES_CLEARED) continue;
+
+            this->clearFlashTimer = CLEAR_FLASH_TIME;
+            this->clearFlashCount = 0;
+            for (int bit = 0; bit < 4; bit++) {
+                if (event.value & (1 << bit)) {
+                    this->clearFlashRows[this->clearFlashCount++] = event.y - bit;
+                }
+            }
         }
+    }
+}
 
-        yOffset += boxSize + 20;
+void Renderer::updateClearFlash(float frameTime) {
+    if (this->clearFlashTimer > 0.0f) {
+        this->clearFlashTimer -= frameTime;
     }
 }
 
-void Renderer::drawUI(const GameState& state) {
-    int uiX = this->nextBoxX;
-    int uiY = this->nextBoxY + 2 * (4 * this->cellSize + 20) + 30;
+void Renderer::drawClearFlash() {
+    if (this->clearFlashTimer <= 0.0f) return;
 
-    DrawText(TextFormat("SCORE: %d", state.score), uiX, uiY, 20, WHITE);
-    DrawText(TextFormat("LEVEL: %d", state.level), uiX, uiY + 30, 20, WHITE);
-    DrawText(TextFormat("LINES: %d", state.linesCleared), uiX, uiY + 60, 20, WHITE);
+    Color flash = WHITE;
+    flash.a = static_cast<unsigned char>(255 * (this->clearFlashTimer / CLEAR_FLASH_TIME));
+
+    for (int i = 0; i < this->clearFlashCount; i++) {
+        int y = this->layout.boardY + this->clearFlashRows[i] * this->layout.cellSize;
+        DrawRectangle(this->layout.boardX, y, 10 * this->layout.cellSize, this->layout.cellSize, flash);
+    }
+}
+
+void Renderer::drawLayer(const RenderTexture2D& layer, int x, int y) {
+    // Render textures are stored upside down
+    Rectangle source = {0.0f, 0.0f, static_cast<float>(layer.texture.width),
+                        -static_cast<float>(layer.texture.height)};
+    DrawTextureRec(layer.texture, source, {static_cast<float>(x), static_cast<float>(y)}, WHITE);
+}
+
+void Renderer::buildStaticLayer() {
+    BeginTextureMode(this->staticLayer);
+    ClearBackground(BLANK);
+
+    int boxSize = this->layout.boxSize;
+
+    // Hold and next boxes
+    DrawText("HOLD", this->layout.holdX, this->layout.holdY - 25, 20, WHITE);
+    DrawRectangle(this->layout.holdX, this->layout.holdY, boxSize, boxSize, toColor(ScreenLayout::PANEL));
+    DrawRectangleLines(this->layout.holdX, this->layout.holdY, boxSize, boxSize, WHITE);
+
+    DrawText("NEXT", this->layout.nextX, this->layout.nextY - 25, 20, WHITE);
+    int yOffset = this->layout.nextY;
+    for (int i = 0; i < ScreenLayout::NEXT_COUNT; i++) {
+        DrawRectangle(this->layout.nextX, yOffset, boxSize, boxSize, toColor(ScreenLayout::PANEL));
+        DrawRectangleLines(this->layout.nextX, yOffset, boxSize, boxSize, WHITE);
+        yOffset += boxSize + ScreenLayout::NEXT_SPACING;
+    }
 
     // Controls
-    int controlsY = this->screenHeight - 200;
+    int controlsY = this->layout.controlsY;
     DrawText("CONTROLS:", 50, controlsY, 16, GRAY);
     DrawText("Arrows: Move", 50, controlsY + 25, 14, GRAY);
     DrawText("X/Z: Rotate", 50, controlsY + 45, 14, GRAY);
     DrawText("Arrow Up: Hard Drop", 50, controlsY + 65, 14, GRAY);
     DrawText("Space: Hold", 50, controlsY + 85, 14, GRAY);
     DrawText("R: Restart", 50, controlsY + 105, 14, GRAY);
+
+    EndTextureMode();
 }
 
-void Renderer::drawGameOver() {
-    int centerX = this->screenWidth / 2;
-    int centerY = this->screenHeight / 2;
+void Renderer::buildGameOverLayer() {
+    int centerX = this->layout.width / 2;
+    int centerY = this->layout.height / 2;
 
-    // Semi-transparent overlay
-    DrawRectangle(0, 0, this->screenWidth, this->screenHeight, {0, 0, 0, 180});
+    BeginTextureMode(this->gameOverLayer);
+    ClearBackground(BLANK);
 
     const char* text = "GAME OVER";
     int textWidth = MeasureText(text, 60);
@@ -303,4 +475,69 @@ void Renderer::drawGameOver() {
     const char* restartText = "Press R to Restart";
     int restartWidth = MeasureText(restartText, 30);
     DrawText(restartText, centerX - restartWidth / 2, centerY + 20, 30, WHITE);
+
+    EndTextureMode();
+}
+
+void Renderer::updateStatsLayer(const GameState& state) {
+    HudValues values = {state.score, state.level, state.linesCleared, state.lastTSpin,
+                        state.lastPerfectClear, state.backToBack, state.combo};
+    if (this->hudValid && values == this->hudValues) {
+        return;
+    }
+    this->hudValues = values;
+    this->hudValid = true;
+
+    BeginTextureMode(this->statsLayer);
+    ClearBackground(BLANK);
+
+    DrawText(TextFormat("SCORE: %d", state.score), 0, 0, 20, WHITE);
+    DrawText(TextFormat("LEVEL: %d", state.level), 0, 30, 20, WHITE);
+    DrawText(TextFormat("LINES: %d", state.linesCleared), 0, 60, 20, WHITE);
+
+    // Bonuses of the last placement and the running chains
+    int bonusY = 100;
+    if (state.lastTSpin != TSpinType::NONE) {
+        DrawText(state.lastTSpin == TSpinType::FULL ? "T-SPIN" : "T-SPIN MINI", 0, bonusY, 20, PURPLE);
+        bonusY += 25;
+    }
+    if (state.lastPerfectClear) {
+        DrawText("PERFECT CLEAR", 0, bonusY, 20, GOLD);
+        bonusY += 25;
+    }
+    if (state.backToBack) {
+        DrawText("BACK-TO-BACK", 0, bonusY, 16, SKYBLUE);
+        bonusY += 20;
+    }
+    if (state.combo > 0) {
+        DrawText(TextFormat("COMBO: %d", state.combo), 0, bonusY, 16, SKYBLUE);
+    }
+
+    EndTextureMode();
+}
+
+void Renderer::drawUI(const GameState& state) {
+    this->updateStatsLayer(state);
+    this->drawLayer(this->statsLayer, this->layout.statsX, this->layout.statsY);
+}
+
+void Renderer::drawScrubBar() {
+    int oldest = this->history->getOldestTick();
+    int current = this->history->getCurrentTick();
+    int span = current > oldest ? current - oldest : 1;
+
+    int barX = this->layout.boardX;
+    int barY = this->layout.boardY - 12;
+    int barWidth = 10 * this->layout.cellSize;
+
+    DrawRectangle(barX, barY, barWidth, 6, {50, 50, 50, 255});
+    DrawRectangle(barX, barY, barWidth * (this->scrubTick - oldest) / span, 6, YELLOW);
+
+    DrawText(TextFormat("REPLAY %d / %d", this->scrubTick, current), barX, barY - 28, 20, YELLOW);
+}
+
+void Renderer::drawGameOver() {
+    // Semi-transparent overlay, then the cached text
+    DrawRectangle(0, 0, this->layout.width, this->layout.height, {0, 0, 0, 180});
+    this->drawLayer(this->gameOverLayer, 0, 0);
 }
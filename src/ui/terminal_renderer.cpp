@@ -0,0 +1,405 @@
+#include "ui/terminal_renderer.hpp"
+#include "engine/tetromino.hpp"
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+    volatile std::sig_atomic_t interrupted = 0;
+
+    void handleInterrupt(int) {
+        interrupted = 1;
+    }
+
+    // Layout (terminal rows/columns, board cells are two columns wide)
+    constexpr int BOARD_ROW = 1;
+    constexpr int BOARD_COL = 16;
+    constexpr int HOLD_COL = 2;
+    constexpr int NEXT_COL = 40;
+
+    constexpr unsigned char COLOR_TEXT = 255;
+    constexpr unsigned char COLOR_DIM = 244;
+    constexpr unsigned char COLOR_BACKGROUND = 0;
+    constexpr unsigned char COLOR_BOARD = 233;
+    constexpr unsigned char COLOR_GRID = 237;
+    constexpr unsigned char COLOR_ALERT = 196;
+}
+
+TerminalRenderer::TerminalRenderer(IGameEngine& game, int framesPerSecond)
+    : gameEngine(game), framesPerSecond(framesPerSecond), rawMode(false),
+      quitRequested(false), simulation(game) {
+
+    // Force a full first draw: nothing matches an all-zero previous frame
+    std::memset(this->lastFrame, 0, sizeof(this->lastFrame));
+    this->output.reserve(FRAME_WIDTH * FRAME_HEIGHT * 16);
+
+    this->enterRawMode();
+    this->setupDefaultKeyMapping();
+}
+
+TerminalRenderer::~TerminalRenderer() {
+    this->leaveRawMode();
+}
+
+void TerminalRenderer::enterRawMode() {
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &this->savedTermios) == 0) {
+        termios raw = this->savedTermios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        this->rawMode = true;
+    }
+
+    std::signal(SIGINT, handleInterrupt);
+
+    // Clear screen, hide cursor
+    this->writeAll("\x1b[2J\x1b[?25l");
+}
+
+void TerminalRenderer::leaveRawMode() {
+    char restore[32];
+    std::snprintf(restore, sizeof(restore), "\x1b[0m\x1b[%d;1H\x1b[?25h", FRAME_HEIGHT + 1);
+    this->writeAll(restore);
+
+    if (this->rawMode) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &this->savedTermios);
+        this->rawMode = false;
+    }
+
+    std::signal(SIGINT, SIG_DFL);
+}
+
+void TerminalRenderer::setupDefaultKeyMapping() {
+    this->mapKey(KEY_ARROW_LEFT, GameEvent::MOVE_LEFT);
+    this->mapKey('h', GameEvent::MOVE_LEFT);
+
+    this->mapKey(KEY_ARROW_RIGHT, GameEvent::MOVE_RIGHT);
+    this->mapKey('l', GameEvent::MOVE_RIGHT);
+
+    this->mapKey(KEY_ARROW_DOWN, GameEvent::MOVE_DOWN);
+    this->mapKey('j', GameEvent::MOVE_DOWN);
+
+    this->mapKey(KEY_ARROW_UP, GameEvent::HARD_DROP);
+    this->mapKey('k', GameEvent::HARD_DROP);
+
+    this->mapKey('z', GameEvent::ROTATE_CCW);
+    this->mapKey('x', GameEvent::ROTATE_CW);
+
+    this->mapKey(' ', GameEvent::HOLD);
+
+    this->mapKey('r', GameEvent::RESTART);
+}
+
+void TerminalRenderer::mapKey(int key, GameEvent event) {
+    this->keyMapping[key] = event;
+}
+
+void TerminalRenderer::clearKeyMapping() {
+    this->keyMapping.clear();
+}
+
+void TerminalRenderer::setTickRate(int ticksPerSecond) {
+    this->simulation.setTickRate(ticksPerSecond);
+}
+
+void TerminalRenderer::run() {
+    using Clock = std::chrono::steady_clock;
+
+    const std::chrono::microseconds frameInterval(1000000 / this->framesPerSecond);
+
+    while (!this->quitRequested && !interrupted) {
+        Clock::time_point frameStart = Clock::now();
+
+        this->processInput();
+
+        // Fixed-rate ticks up to now, with this frame's keys in order
+        this->simulation.advance(Clock::now());
+
+        // Render into the back frame, then send only the differences
+        GameState state = this->gameEngine.getState();
+
+        this->clearFrame();
+        this->drawBoard(state);
+        this->drawPiece(state);
+        this->drawSidebars(state);
+
+        if (state.gameOver) {
+            this->drawGameOver();
+        }
+
+        this->flush();
+
+        std::this_thread::sleep_until(frameStart + frameInterval);
+    }
+}
+
+void TerminalRenderer::processInput() {
+    if (!this->rawMode) {
+        return;
+    }
+
+    char buffer[64];
+    ssize_t length = read(STDIN_FILENO, buffer, sizeof(buffer));
+
+    for (ssize_t i = 0; i < length; i++) {
+        int key = static_cast<unsigned char>(buffer[i]);
+
+        // Arrow keys arrive as ESC [ A..D
+        if (key == 0x1b && i + 2 < length && buffer[i + 1] == '[') {
+            switch (buffer[i + 2]) {
+                case 'A': key = KEY_ARROW_UP; break;
+                case 'B': key = KEY_ARROW_DOWN; break;
+                case 'C': key = KEY_ARROW_RIGHT; break;
+                case 'D': key = KEY_ARROW_LEFT; break;
+                default: break;
+            }
+            i += 2;
+        } else if (key >= 'A' && key <= 'Z') {
+            key += 'a' - 'A';
+        }
+
+        if (key == 'q') {
+            this->quitRequested = true;
+            return;
+        }
+
+        auto mapping = this->keyMapping.find(key);
+        if (mapping != this->keyMapping.end()) {
+            this->simulation.push(mapping->second, SimulationLoop::Clock::now());
+        }
+    }
+}
+
+unsigned char TerminalRenderer::getColorForType(TetrominoType type) const {
+    switch (type) {
+        case TetrominoType::I: return 51;     // Cyan
+        case TetrominoType::O: return 226;    // Yellow
+        case TetrominoType::T: return 129;    // Purple
+        case TetrominoType::S: return 46;     // Green
+        case TetrominoType::Z: return 196;    // Red
+        case TetrominoType::J: return 21;     // Blue
+        case TetrominoType::L: return 208;    // Orange
+        default: return 244;                  // Gray
+    }
+}
+
+void TerminalRenderer::clearFrame() {
+    for (int row = 0; row < FRAME_HEIGHT; row++) {
+        for (int col = 0; col < FRAME_WIDTH; col++) {
+            this->frame[row][col] = {' ', COLOR_TEXT, COLOR_BACKGROUND};
+        }
+    }
+}
+
+void TerminalRenderer::putText(int row, int col, const char* text, unsigned char fg) {
+    for (int i = 0; text[i] != '\0' && col + i < FRAME_WIDTH; i++) {
+        this->frame[row][col + i] = {text[i], fg, COLOR_BACKGROUND};
+    }
+}
+
+void TerminalRenderer::putCell(int row, int col, TetrominoType type, bool ghost) {
+    if (row < 0 || col < 0 || row >= FRAME_HEIGHT || col + 1 >= FRAME_WIDTH) {
+        return;
+    }
+
+    unsigned char color = this->getColorForType(type);
+
+    if (ghost) {
+        this->frame[row][col] = {'[', color, COLOR_BOARD};
+        this->frame[row][col + 1] = {']', color, COLOR_BOARD};
+    } else {
+        this->frame[row][col] = {' ', color, color};
+        this->frame[row][col + 1] = {' ', color, color};
+    }
+}
+
+void TerminalRenderer::drawBoard(const GameState& state) {
+    for (int row = 0; row < 20; row++) {
+        int y = BOARD_ROW + row;
+        this->frame[y][BOARD_COL - 1] = {'|', COLOR_DIM, COLOR_BACKGROUND};
+        this->frame[y][BOARD_COL + 20] = {'|', COLOR_DIM, COLOR_BACKGROUND};
+
+        for (int col = 0; col < 10; col++) {
+            int x = BOARD_COL + col * 2;
+
+            if (state.board[row][col] != 0) {
+                this->putCell(y, x, static_cast<TetrominoType>(state.board[row][col]), false);
+            } else {
+                this->frame[y][x] = {' ', COLOR_GRID, COLOR_BOARD};
+                this->frame[y][x + 1] = {'.', COLOR_GRID, COLOR_BOARD};
+            }
+        }
+    }
+
+    for (int col = BOARD_COL - 1; col <= BOARD_COL + 20; col++) {
+        this->frame[BOARD_ROW + 20][col] = {'-', COLOR_DIM, COLOR_BACKGROUND};
+    }
+}
+
+void TerminalRenderer::drawPiece(const GameState& state) {
+    const PieceShape& shape = Tetromino::getShape(state.currentPieceType, state.currentPieceOrientation);
+
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (!shape.isFilled(row, col)) {
+                continue;
+            }
+
+            int x = BOARD_COL + (state.currentPieceX + col) * 2;
+            int ghostY = state.ghostPieceY + row;
+            int pieceY = state.currentPieceY + row;
+
+            if (ghostY >= 0 && ghostY < 20) {
+                this->putCell(BOARD_ROW + ghostY, x, state.currentPieceType, true);
+            }
+            if (pieceY >= 0 && pieceY < 20) {
+                this->putCell(BOARD_ROW + pieceY, x, state.currentPieceType, false);
+            }
+        }
+    }
+}
+
+void TerminalRenderer::drawPreviewPiece(TetrominoType type, int row, int col) {
+    if (type == TetrominoType::NONE) return;
+
+    const PieceShape& shape = Tetromino::getShape(type, Orientation::NORTH);
+
+    for (int r = 0; r < 2; r++) {
+        for (int c = 0; c < 4; c++) {
+            // Start at the top filled row (the I piece sits on its second row)
+            int shapeRow = shape.minRow + r;
+            if (shapeRow < 4 && shape.isFilled(shapeRow, c)) {
+                this->putCell(row + r, col + c * 2, type, false);
+            }
+        }
+    }
+}
+
+void TerminalRenderer::drawSidebars(const GameState& state) {
+    char line[32];
+
+    this->putText(BOARD_ROW, HOLD_COL, "HOLD", state.canHold ? COLOR_TEXT : COLOR_DIM);
+    if (state.hasHeldPiece) {
+        this->drawPreviewPiece(state.heldPieceType, BOARD_ROW + 2, HOLD_COL);
+    }
+
+    this->putText(BOARD_ROW, NEXT_COL, "NEXT", COLOR_TEXT);
+    for (int i = 0; i < 2; i++) {
+        this->drawPreviewPiece(state.nextPieces[i], BOARD_ROW + 2 + i * 3, NEXT_COL);
+    }
+
+    std::snprintf(line, sizeof(line), "SCORE: %d", state.score);
+    this->putText(BOARD_ROW + 9, NEXT_COL, line, COLOR_TEXT);
+    std::snprintf(line, sizeof(line), "LEVEL: %d", state.level);
+    this->putText(BOARD_ROW + 10, NEXT_COL, line, COLOR_TEXT);
+    std::snprintf(line, sizeof(line), "LINES: %d", state.linesCleared);
+    this->putText(BOARD_ROW + 11, NEXT_COL, line, COLOR_TEXT);
+
+    if (state.pendingGarbage > 0) {
+        std::snprintf(line, sizeof(line), "GARBAGE: %d", state.pendingGarbage);
+        this->putText(BOARD_ROW + 13, NEXT_COL, line, COLOR_ALERT);
+    }
+
+    // Bonuses of the last placement and the running chains
+    int bonusRow = BOARD_ROW + 15;
+    if (state.lastTSpin != TSpinType::NONE) {
+        this->putText(bonusRow++, NEXT_COL, state.lastTSpin == TSpinType::FULL ? "T-SPIN" : "T-SPIN MINI", COLOR_TEXT);
+    }
+    if (state.lastPerfectClear) {
+        this->putText(bonusRow++, NEXT_COL, "PERFECT CLEAR", COLOR_TEXT);
+    }
+    if (state.backToBack) {
+        this->putText(bonusRow++, NEXT_COL, "BACK-TO-BACK", COLOR_DIM);
+    }
+    if (state.combo > 0) {
+        std::snprintf(line, sizeof(line), "COMBO: %d", state.combo);
+        this->putText(bonusRow, NEXT_COL, line, COLOR_DIM);
+    }
+
+    // Controls
+    this->putText(BOARD_ROW + 9, HOLD_COL, "CONTROLS:", COLOR_DIM);
+    this->putText(BOARD_ROW + 10, HOLD_COL, "hjkl/arrows", COLOR_DIM);
+    this->putText(BOARD_ROW + 11, HOLD_COL, "x/z: rotate", COLOR_DIM);
+    this->putText(BOARD_ROW + 12, HOLD_COL, "space: hold", COLOR_DIM);
+    this->putText(BOARD_ROW + 13, HOLD_COL, "r: restart", COLOR_DIM);
+    this->putText(BOARD_ROW + 14, HOLD_COL, "q: quit", COLOR_DIM);
+}
+
+void TerminalRenderer::drawGameOver() {
+    this->putText(BOARD_ROW + 9, BOARD_COL + 5, "GAME OVER", COLOR_ALERT);
+    this->putText(BOARD_ROW + 11, BOARD_COL + 3, "R to restart", COLOR_TEXT);
+}
+
+void TerminalRenderer::flush() {
+    this->output.clear();
+
+    int cursorRow = -1;
+    int cursorCol = -1;
+    int currentFg = -1;
+    int currentBg = -1;
+    char sequence[32];
+
+    for (int row = 0; row < FRAME_HEIGHT; row++) {
+        for (int col = 0; col < FRAME_WIDTH; col++) {
+            const Cell& cell = this->frame[row][col];
+            if (cell == this->lastFrame[row][col]) {
+                continue;
+            }
+
+            // Only move the cursor when the changed cell is not the next one
+            if (row != cursorRow || col != cursorCol) {
+                std::snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row + 1, col + 1);
+                this->output += sequence;
+            }
+
+            if (cell.fg != currentFg || cell.bg != currentBg) {
+                std::snprintf(sequence, sizeof(sequence), "\x1b[38;5;%d;48;5;%dm", cell.fg, cell.bg);
+                this->output += sequence;
+                currentFg = cell.fg;
+                currentBg = cell.bg;
+            }
+
+            this->output += cell.ch;
+            cursorRow = row;
+            cursorCol = col + 1;
+
+            this->lastFrame[row][col] = cell;
+        }
+    }
+
+    if (!this->output.empty()) {
+        this->output += "\x1b[0m";
+        if (!this->writeAll(this->output)) {
+            // The terminal may hold any part of this frame: redraw everything next time
+            std::memset(this->lastFrame, 0, sizeof(this->lastFrame));
+        }
+    }
+}
+
+bool TerminalRenderer::writeAll(const std::string& data) {
+    size_t written = 0;
+
+    while (written < data.size()) {
+        ssize_t result = write(STDOUT_FILENO, data.data() + written, data.size() - written);
+        if (result > 0) {
+            written += static_cast<size_t>(result);
+        } else if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Non-blocking stdout (set by another process sharing the tty): wait until it drains
+            pollfd descriptor = {STDOUT_FILENO, POLLOUT, 0};
+            if (poll(&descriptor, 1, 100) < 0 && errno != EINTR) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,108 @@
+#include "video/frame_pipeline.hpp"
+#include <algorithm>
+
+FramePipeline::FramePipeline(const FrameRasterizer& rasterizer, int threads, Writer writer)
+    : rasterizer(rasterizer), writer(std::move(writer)) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    // Two frames per renderer keeps everyone busy while the writer drains
+    this->slots.resize(static_cast<std::size_t>(threads) * 2 + 2);
+    for (Slot& slot : this->slots) {
+        slot.pixels.resize(rasterizer.getFrameBytes());
+    }
+
+    for (int i = 0; i < threads; i++) {
+        this->workers.emplace_back(&FramePipeline::renderLoop, this);
+    }
+    this->writerThread = std::thread(&FramePipeline::writeLoop, this);
+}
+
+FramePipeline::~FramePipeline() {
+    this->finish();
+}
+
+bool FramePipeline::push(const FrameInfo& frame) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    Slot& slot = this->slots[this->pushed % this->slots.size()];
+    this->changed.wait(lock, [&] { return slot.state == SlotState::FREE || this->failed; });
+    if (this->failed || this->closing) {
+        return false;
+    }
+
+    slot.frame = frame;
+    slot.state = SlotState::QUEUED;
+    this->pushed++;
+    this->changed.notify_all();
+    return true;
+}
+
+bool FramePipeline::finish() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closing = true;
+        this->changed.notify_all();
+    }
+
+    for (std::thread& worker : this->workers) {
+        worker.join();
+    }
+    this->workers.clear();
+    if (this->writerThread.joinable()) {
+        this->writerThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return !this->failed;
+}
+
+uint64_t FramePipeline::getFramesWritten() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->nextToWrite;
+}
+
+void FramePipeline::renderLoop() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    for (;;) {
+        this->changed.wait(lock, [&] { return this->nextToRender < this->pushed || this->closing; });
+        if (this->nextToRender >= this->pushed) {
+            return;
+        }
+
+        // Frames are claimed in order, but finish in any order
+        Slot& slot = this->slots[this->nextToRender++ % this->slots.size()];
+        lock.unlock();
+        this->rasterizer.render(slot.frame, slot.pixels.data());
+        lock.lock();
+
+        slot.state = SlotState::RENDERED;
+        this->changed.notify_all();
+    }
+}
+
+void FramePipeline::writeLoop() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    for (;;) {
+        Slot& slot = this->slots[this->nextToWrite % this->slots.size()];
+        this->changed.wait(lock, [&] {
+            return slot.state == SlotState::RENDERED || (this->closing && this->nextToWrite == this->pushed);
+        });
+        if (slot.state != SlotState::RENDERED) {
+            return;
+        }
+
+        // After a failure frames are still drained, so renderers never block
+        bool skip = this->failed;
+        lock.unlock();
+        bool ok = skip || this->writer(slot.pixels.data(), slot.pixels.size());
+        lock.lock();
+
+        this->failed = this->failed || !ok;
+        slot.state = SlotState::FREE;
+        this->nextToWrite++;
+        this->changed.notify_all();
+    }
+}
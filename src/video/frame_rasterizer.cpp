@@ -0,0 +1,317 @@
+#include "video/frame_rasterizer.hpp"
+#include "engine/tetromino.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    // The raylib colors Renderer uses
+    constexpr Rgba BLACK = {0, 0, 0, 255};
+    constexpr Rgba WHITE = {255, 255, 255, 255};
+    constexpr Rgba GRAY = {130, 130, 130, 255};
+    constexpr Rgba RED = {230, 41, 55, 255};
+    constexpr Rgba PURPLE = {200, 122, 255, 255};
+    constexpr Rgba GOLD = {255, 203, 0, 255};
+    constexpr Rgba SKYBLUE = {102, 191, 255, 255};
+
+    // 5x7 glyphs, one byte per row with the leftmost pixel in bit 4
+    const char GLYPH_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789:-/";
+    const uint8_t GLYPHS[][7] = {
+        {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // A
+        {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},  // B
+        {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},  // C
+        {0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E},  // D
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},  // E
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},  // F
+        {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},  // G
+        {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // H
+        {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // I
+        {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  // J
+        {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // K
+        {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},  // L
+        {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},  // M
+        {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // N
+        {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // O
+        {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},  // P
+        {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},  // Q
+        {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},  // R
+        {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},  // S
+        {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // T
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // U
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},  // V
+        {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},  // W
+        {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},  // X
+        {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},  // Y
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},  // Z
+        {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // 0
+        {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 1
+        {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // 2
+        {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // 3
+        {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // 4
+        {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // 5
+        {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // 6
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+        {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // 8
+        {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // 9
+        {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},  // :
+        {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},  // -
+        {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},  // /
+    };
+    constexpr int GLYPH_WIDTH = 5;
+    constexpr int GLYPH_HEIGHT = 7;
+
+    // Raylib's default font is 10 px high; glyphs scale by whole pixels
+    int fontScale(int fontSize) {
+        return std::max(1, (fontSize + 5) / 10);
+    }
+
+    const uint8_t* findGlyph(char c) {
+        if (c >= 'a' && c <= 'z') {
+            c = static_cast<char>(c - 'a' + 'A');
+        }
+        const char* found = c != '\0' ? std::strchr(GLYPH_CHARS, c) : nullptr;
+        return found != nullptr ? GLYPHS[found - GLYPH_CHARS] : nullptr;
+    }
+}
+
+FrameRasterizer::FrameRasterizer(const ScreenLayout& layout) : layout(layout) {
+    this->background.resize(static_cast<std::size_t>(layout.width) * layout.height * 4);
+    this->buildBackground();
+}
+
+void FrameRasterizer::fillRect(uint8_t* pixels, int x, int y, int width, int height, Rgba color) const {
+    int x0 = std::max(0, x);
+    int y0 = std::max(0, y);
+    int x1 = std::min(this->layout.width, x + width);
+    int y1 = std::min(this->layout.height, y + height);
+    if (x0 >= x1 || y0 >= y1 || color.a == 0) return;
+
+    for (int row = y0; row < y1; row++) {
+        uint8_t* pixel = pixels + (static_cast<std::size_t>(row) * this->layout.width + x0) * 4;
+        if (color.a == 255) {
+            for (int col = x0; col < x1; col++, pixel += 4) {
+                pixel[0] = color.r;
+                pixel[1] = color.g;
+                pixel[2] = color.b;
+                pixel[3] = 255;
+            }
+        } else {
+            // Source-over onto an opaque framebuffer
+            int alpha = color.a;
+            for (int col = x0; col < x1; col++, pixel += 4) {
+                pixel[0] = static_cast<uint8_t>((color.r * alpha + pixel[0] * (255 - alpha)) / 255);
+                pixel[1] = static_cast<uint8_t>((color.g * alpha + pixel[1] * (255 - alpha)) / 255);
+                pixel[2] = static_cast<uint8_t>((color.b * alpha + pixel[2] * (255 - alpha)) / 255);
+            }
+        }
+    }
+}
+
+void FrameRasterizer::strokeRect(uint8_t* pixels, int x, int y, int width, int height, Rgba color) const {
+    // One pixel inside the rectangle, like DrawRectangleLines
+    this->fillRect(pixels, x, y, width, 1, color);
+    this->fillRect(pixels, x, y + height - 1, width, 1, color);
+    this->fillRect(pixels, x, y + 1, 1, height - 2, color);
+    this->fillRect(pixels, x + width - 1, y + 1, 1, height - 2, color);
+}
+
+int FrameRasterizer::measureText(const char* text, int fontSize) {
+    int length = static_cast<int>(std::strlen(text));
+    return length > 0 ? (length * (GLYPH_WIDTH + 1) - 1) * fontScale(fontSize) : 0;
+}
+
+void FrameRasterizer::drawText(uint8_t* pixels, const char* text, int x, int y, int fontSize,
+                               Rgba color) const {
+    int scale = fontScale(fontSize);
+    int top = y + (fontSize - GLYPH_HEIGHT * scale) / 2;
+
+    for (const char* c = text; *c != '\0'; c++, x += (GLYPH_WIDTH + 1) * scale) {
+        const uint8_t* glyph = findGlyph(*c);
+        if (glyph == nullptr) continue;
+
+        for (int row = 0; row < GLYPH_HEIGHT; row++) {
+            for (int col = 0; col < GLYPH_WIDTH; col++) {
+                if (glyph[row] & (0x10 >> col)) {
+                    this->fillRect(pixels, x + col * scale, top + row * scale, scale, scale, color);
+                }
+            }
+        }
+    }
+}
+
+void FrameRasterizer::drawCell(uint8_t* pixels, int x, int y, TetrominoType type, float alpha) const {
+    Rgba color = ScreenLayout::pieceColor(type);
+    color.a = static_cast<uint8_t>(255 * alpha);
+
+    int size = this->layout.cellSize;
+    this->fillRect(pixels, x + 1, y + 1, size - 2, size - 2, color);
+    this->strokeRect(pixels, x, y, size, size, WHITE);
+}
+
+void FrameRasterizer::drawPieceShape(uint8_t* pixels, TetrominoType type, Orientation orientation,
+                                     int offsetX, int offsetY, float alpha) const {
+    const PieceShape& shape = Tetromino::getShape(type, orientation);
+    int size = this->layout.cellSize;
+
+    for (int row = shape.minRow; row <= shape.maxRow; row++) {
+        for (int col = shape.minCol; col <= shape.maxCol; col++) {
+            if (shape.isFilled(row, col)) {
+                this->drawCell(pixels, offsetX + col * size, offsetY + row * size, type, alpha);
+            }
+        }
+    }
+}
+
+void FrameRasterizer::drawCenteredPiece(uint8_t* pixels, TetrominoType type, int boxX, int boxY,
+                                        float alpha) const {
+    if (type == TetrominoType::NONE) return;
+
+    const PieceShape& shape = Tetromino::getShape(type, Orientation::NORTH);
+    if (shape.mask == 0) return;
+
+    int size = this->layout.cellSize;
+    int boxSize = this->layout.boxSize;
+    int pieceWidth = (shape.maxCol - shape.minCol + 1) * size;
+    int pieceHeight = (shape.maxRow - shape.minRow + 1) * size;
+
+    int centeredX = boxX + (boxSize - pieceWidth) / 2 - (shape.minCol * size);
+    int centeredY = boxY + (boxSize - pieceHeight) / 2 - (shape.minRow * size);
+
+    this->drawPieceShape(pixels, type, Orientation::NORTH, centeredX, centeredY, alpha);
+}
+
+void FrameRasterizer::drawBoard(uint8_t* pixels, const GameState& state) const {
+    int size = this->layout.cellSize;
+
+    // Board background, grid and locked cells
+    this->fillRect(pixels, this->layout.boardX, this->layout.boardY, 10 * size, 20 * size, ScreenLayout::PANEL);
+    for (int row = 0; row < 20; row++) {
+        for (int col = 0; col < 10; col++) {
+            int x = this->layout.boardX + col * size;
+            int y = this->layout.boardY + row * size;
+
+            this->strokeRect(pixels, x, y, size, size, ScreenLayout::GRID);
+            if (state.board[row][col] != 0) {
+                this->drawCell(pixels, x, y, static_cast<TetrominoType>(state.board[row][col]), 1.0f);
+            }
+        }
+    }
+
+    // Ghost, then the piece itself
+    int pieceX = this->layout.boardX + state.currentPieceX * size;
+    this->drawPieceShape(pixels, state.currentPieceType, state.currentPieceOrientation, pieceX,
+                         this->layout.boardY + state.ghostPieceY * size, 0.3f);
+    this->drawPieceShape(pixels, state.currentPieceType, state.currentPieceOrientation, pieceX,
+                         this->layout.boardY + state.currentPieceY * size, 1.0f);
+}
+
+void FrameRasterizer::drawStats(uint8_t* pixels, const GameState& state) const {
+    int x = this->layout.statsX;
+    int y = this->layout.statsY;
+    char text[32];
+
+    std::snprintf(text, sizeof(text), "SCORE: %d", state.score);
+    this->drawText(pixels, text, x, y, 20, WHITE);
+    std::snprintf(text, sizeof(text), "LEVEL: %d", state.level);
+    this->drawText(pixels, text, x, y + 30, 20, WHITE);
+    std::snprintf(text, sizeof(text), "LINES: %d", state.linesCleared);
+    this->drawText(pixels, text, x, y + 60, 20, WHITE);
+
+    int bonusY = y + 100;
+    if (state.lastTSpin != TSpinType::NONE) {
+        this->drawText(pixels, state.lastTSpin == TSpinType::FULL ? "T-SPIN" : "T-SPIN MINI", x, bonusY, 20, PURPLE);
+        bonusY += 25;
+    }
+    if (state.lastPerfectClear) {
+        this->drawText(pixels, "PERFECT CLEAR", x, bonusY, 20, GOLD);
+        bonusY += 25;
+    }
+    if (state.backToBack) {
+        this->drawText(pixels, "BACK-TO-BACK", x, bonusY, 16, SKYBLUE);
+        bonusY += 20;
+    }
+    if (state.combo > 0) {
+        std::snprintf(text, sizeof(text), "COMBO: %d", state.combo);
+        this->drawText(pixels, text, x, bonusY, 16, SKYBLUE);
+    }
+}
+
+void FrameRasterizer::drawGameOver(uint8_t* pixels) const {
+    int centerX = this->layout.width / 2;
+    int centerY = this->layout.height / 2;
+
+    this->fillRect(pixels, 0, 0, this->layout.width, this->layout.height, {0, 0, 0, 180});
+
+    const char* text = "GAME OVER";
+    this->drawText(pixels, text, centerX - measureText(text, 60) / 2, centerY - 60, 60, RED);
+    const char* restartText = "Press R to Restart";
+    this->drawText(pixels, restartText, centerX - measureText(restartText, 30) / 2, centerY + 20, 30, WHITE);
+}
+
+void FrameRasterizer::buildBackground() {
+    uint8_t* pixels = this->background.data();
+    this->fillRect(pixels, 0, 0, this->layout.width, this->layout.height, BLACK);
+
+    int boxSize = this->layout.boxSize;
+
+    // Hold and next boxes
+    this->drawText(pixels, "HOLD", this->layout.holdX, this->layout.holdY - 25, 20, WHITE);
+    this->fillRect(pixels, this->layout.holdX, this->layout.holdY, boxSize, boxSize, ScreenLayout::PANEL);
+    this->strokeRect(pixels, this->layout.holdX, this->layout.holdY, boxSize, boxSize, WHITE);
+
+    this->drawText(pixels, "NEXT", this->layout.nextX, this->layout.nextY - 25, 20, WHITE);
+    int yOffset = this->layout.nextY;
+    for (int i = 0; i < ScreenLayout::NEXT_COUNT; i++) {
+        this->fillRect(pixels, this->layout.nextX, yOffset, boxSize, boxSize, ScreenLayout::PANEL);
+        this->strokeRect(pixels, this->layout.nextX, yOffset, boxSize, boxSize, WHITE);
+        yOffset += boxSize + ScreenLayout::NEXT_SPACING;
+    }
+
+    // Controls
+    int controlsY = this->layout.controlsY;
+    this->drawText(pixels, "CONTROLS:", 50, controlsY, 16, GRAY);
+    this->drawText(pixels, "Arrows: Move", 50, controlsY + 25, 14, GRAY);
+    this->drawText(pixels, "X/Z: Rotate", 50, controlsY + 45, 14, GRAY);
+    this->drawText(pixels, "Arrow Up: Hard Drop", 50, controlsY + 65, 14, GRAY);
+    this->drawText(pixels, "Space: Hold", 50, controlsY + 85, 14, GRAY);
+    this->drawText(pixels, "R: Restart", 50, controlsY + 105, 14, GRAY);
+}
+
+void FrameRasterizer::render(const FrameInfo& frame, uint8_t* pixels) const {
+    const GameState& state = frame.state;
+    std::memcpy(pixels, this->background.data(), this->background.size());
+
+    this->drawBoard(pixels, state);
+
+    if (frame.clearFlash > 0.0f) {
+        Rgba flash = WHITE;
+        flash.a = static_cast<uint8_t>(255 * std::min(1.0f, frame.clearFlash));
+        for (int i = 0; i < frame.clearFlashCount; i++) {
+            int y = this->layout.boardY + frame.clearFlashRows[i] * this->layout.cellSize;
+            this->fillRect(pixels, this->layout.boardX, y, 10 * this->layout.cellSize, this->layout.cellSize, flash);
+        }
+    }
+
+    if (state.hasHeldPiece) {
+        this->drawCenteredPiece(pixels, state.heldPieceType, this->layout.holdX, this->layout.holdY,
+                                state.canHold ? 1.0f : 0.4f);
+    }
+    int yOffset = this->layout.nextY;
+    for (int i = 0; i < ScreenLayout::NEXT_COUNT; i++) {
+        this->drawCenteredPiece(pixels, state.nextPieces[i], this->layout.nextX, yOffset, 1.0f);
+        yOffset += this->layout.boxSize + ScreenLayout::NEXT_SPACING;
+    }
+
+    if (state.pendingGarbage > 0) {
+        // Red bar along the left edge of the board, one cell per incoming line
+        int height = std::min(state.pendingGarbage, 20) * this->layout.cellSize;
+        this->fillRect(pixels, this->layout.boardX - 8, this->layout.boardY + 20 * this->layout.cellSize - height,
+                       6, height, RED);
+    }
+
+    this->drawStats(pixels, state);
+
+    if (state.gameOver) {
+        this->drawGameOver(pixels);
+    }
+}
@@ -0,0 +1,400 @@
+// Opening book builder.
+//
+// Walks every 7-bag piece order the opening can deal (branching on each
+// newly revealed preview piece), picks a move for every position with a
+// deeper search than an agent can afford in real time, and writes the
+// moves to a sorted book file for OpeningBook / BookAgent. It then plays
+// games with the book to report how much of the opening it covers.
+//
+//   build/tools/book_builder --out opening.book --plies 5
+//   build/tools/sim_farm --agent heuristic --book opening.book
+
+#include "bot/agent_factory.hpp"
+#include "bot/book_agent.hpp"
+#include "bot/heuristic_agent.hpp"
+#include "bot/opening_book.hpp"
+#include "engine/game.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    constexpr int BAG_SIZE = 7;
+    constexpr int PREVIEW = 2;
+
+    struct Options {
+        std::string out = "opening.book";
+        int plies = 5;
+        int beam = 24;
+        int threads = 0;
+        int verifyGames = 1000;
+    };
+
+    // A position on the opening tree: pieces are dealt from seq, and
+    // `drawn` of them have left the queue (the current piece included)
+    struct Position {
+        PlacementSearch::Board board;
+        TetrominoType current;
+        TetrominoType hold;
+        int drawn;
+    };
+
+    struct Move {
+        Placement placement;
+        bool hold;
+    };
+
+    // Beam search over the pieces visible at spawn (current, hold and the
+    // preview), scoring the final board with the heuristic evaluator
+    class MoveSearch {
+    private:
+        struct Node {
+            PlacementSearch::Board board;
+            TetrominoType current;
+            TetrominoType hold;
+            int nextIndex;
+            int placed;
+            int lines;
+            double score;
+            Move first;
+        };
+
+        HeuristicAgent evaluator;
+        int beam;
+        std::vector<Node> layer;
+        std::vector<Node> children;
+        std::vector<Placement> placements;
+
+        void expand(const Node& node, TetrominoType piece, TetrominoType hold, TetrominoType current,
+                    int nextIndex, bool held) {
+            PlacementSearch::enumerate(node.board, piece, Orientation::NORTH,
+                                       PlacementSearch::SPAWN_X, PlacementSearch::SPAWN_Y, this->placements);
+
+            for (const Placement& placement : this->placements) {
+                this->children.emplace_back();
+                Node& child = this->children.back();
+                BoardFeatures features = PlacementSearch::evaluate(node.board, placement, child.board);
+                child.current = current;
+                child.hold = hold;
+                child.nextIndex = nextIndex;
+                child.placed = node.placed + 1;
+                child.lines = node.lines + features.linesCleared;
+                features.linesCleared = child.lines;
+                child.score = this->evaluator.score(features);
+                child.first = node.placed == 0 ? Move{placement, held} : node.first;
+            }
+        }
+
+    public:
+        explicit MoveSearch(int beam) : beam(beam) {}
+
+        bool choose(const PlacementSearch::Board& board, TetrominoType current, TetrominoType hold,
+                    const TetrominoType (&preview)[PREVIEW], Move& out) {
+            this->layer.clear();
+            this->layer.emplace_back();
+            Node& root = this->layer.back();
+            std::memcpy(root.board, board, sizeof(PlacementSearch::Board));
+            root.current = current;
+            root.hold = hold;
+            root.nextIndex = 0;
+            root.placed = 0;
+            root.lines = 0;
+            root.score = 0.0;
+
+            bool found = false;
+            double bestScore = -std::numeric_limits<double>::infinity();
+            int bestPlaced = 0;
+
+            while (!this->layer.empty()) {
+                this->children.clear();
+
+                for (const Node& node : this->layer) {
+                    auto visible = [&](int index) {
+                        return index < PREVIEW ? preview[index] : TetrominoType::NONE;
+                    };
+
+                    // Place the current piece
+                    this->expand(node, node.current, node.hold, visible(node.nextIndex), node.nextIndex + 1, false);
+
+                    // Or hold first, once per piece
+                    if (node.hold == TetrominoType::NONE) {
+                        TetrominoType next = visible(node.nextIndex);
+                        if (next != TetrominoType::NONE) {
+                            this->expand(node, next, node.current, visible(node.nextIndex + 1),
+                                         node.nextIndex + 2, true);
+                        }
+                    } else if (node.hold != node.current) {
+                        this->expand(node, node.hold, node.current, visible(node.nextIndex),
+                                     node.nextIndex + 1, true);
+                    }
+                }
+
+                // Complete lines (no visible piece left) compete only with
+                // lines that placed as many pieces
+                this->layer.clear();
+                for (Node& child : this->children) {
+                    if (child.current != TetrominoType::NONE) {
+                        this->layer.push_back(child);
+                    } else if (child.placed > bestPlaced || (child.placed == bestPlaced && child.score > bestScore)) {
+                        bestPlaced = child.placed;
+                        bestScore = child.score;
+                        out = child.first;
+                        found = true;
+                    }
+                }
+
+                if (static_cast<int>(this->layer.size()) > this->beam) {
+                    std::partial_sort(this->layer.begin(), this->layer.begin() + this->beam, this->layer.end(),
+                                      [](const Node& a, const Node& b) { return a.score > b.score; });
+                    this->layer.resize(this->beam);
+                }
+            }
+
+            return found;
+        }
+    };
+
+    // Walks the opening tree below one root and collects its book entries
+    class Builder {
+    private:
+        const Options& options;
+        MoveSearch search;
+        std::vector<TetrominoType> seq;
+        // (position key, pieces drawn, pieces used from the open bag) already expanded
+        std::unordered_set<uint64_t> expanded;
+
+    public:
+        std::vector<BookEntry> entries;
+
+        explicit Builder(const Options& options) : options(options), search(options.beam) {}
+
+        bool allowed(TetrominoType type) const {
+            std::size_t bagStart = this->seq.size() - this->seq.size() % BAG_SIZE;
+            for (std::size_t i = bagStart; i < this->seq.size(); i++) {
+                if (this->seq[i] == type) return false;
+            }
+            return true;
+        }
+
+        uint32_t bagMask(int count) const {
+            uint32_t mask = 0;
+            for (int i = count - count % BAG_SIZE; i < count; i++) {
+                mask |= 1u << static_cast<int>(this->seq[i]);
+            }
+            return mask;
+        }
+
+        void visit(const Position& position, int ply) {
+            // Reveal the preview; every order the bags allow is a branch
+            if (static_cast<int>(this->seq.size()) < position.drawn + PREVIEW) {
+                for (int t = 1; t <= BAG_SIZE; t++) {
+                    TetrominoType type = static_cast<TetrominoType>(t);
+                    if (!this->allowed(type)) continue;
+                    this->seq.push_back(type);
+                    this->visit(position, ply);
+                    this->seq.pop_back();
+                }
+                return;
+            }
+
+            TetrominoType preview[PREVIEW] = {this->seq[position.drawn], this->seq[position.drawn + 1]};
+            uint64_t key = OpeningBook::hashPosition(position.board, position.current, position.hold, true,
+                                                     preview[0], preview[1]);
+
+            // The same position with the same bag state has the same subtree
+            int known = position.drawn + PREVIEW;
+            uint64_t visitKey = key ^ (static_cast<uint64_t>(known) << 40) ^
+                                (static_cast<uint64_t>(this->bagMask(known)) << 48);
+            if (!this->expanded.insert(visitKey).second) {
+                return;
+            }
+
+            Move move;
+            if (!this->search.choose(position.board, position.current, position.hold, preview, move)) {
+                return;
+            }
+
+            BookEntry entry = {};
+            entry.key = key;
+            entry.type = static_cast<uint8_t>(move.placement.type);
+            entry.orientation = static_cast<uint8_t>(move.placement.orientation);
+            entry.x = static_cast<int8_t>(move.placement.x);
+            entry.y = static_cast<int8_t>(move.placement.y);
+            entry.rotations = static_cast<int8_t>(move.placement.rotations);
+            entry.shift = static_cast<int8_t>(move.placement.shift);
+            entry.hold = move.hold ? 1 : 0;
+            this->entries.push_back(entry);
+
+            if (ply + 1 >= this->options.plies) {
+                return;
+            }
+
+            // Play the move the way Game would
+            Position next;
+            PlacementSearch::evaluate(position.board, move.placement, next.board);
+            next.hold = position.hold;
+            next.drawn = position.drawn;
+            if (move.hold) {
+                next.hold = position.current;
+                if (position.hold == TetrominoType::NONE) {
+                    next.drawn++;
+                }
+            }
+            next.current = this->seq[next.drawn];
+            next.drawn++;
+
+            this->visit(next, ply + 1);
+        }
+
+        // Root: the first piece and the preview are fixed by the caller
+        void build(const TetrominoType (&opening)[PREVIEW + 1]) {
+            this->seq.assign(opening, opening + PREVIEW + 1);
+
+            Position root;
+            std::memset(root.board, 0, sizeof(root.board));
+            root.current = opening[0];
+            root.hold = TetrominoType::NONE;
+            root.drawn = 1;
+            this->visit(root, 0);
+        }
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const char* arg = argv[i];
+            const char* value = argv[i + 1];
+
+            if (std::strcmp(arg, "--out") == 0) options.out = value;
+            else if (std::strcmp(arg, "--plies") == 0) options.plies = std::atoi(value);
+            else if (std::strcmp(arg, "--beam") == 0) options.beam = std::atoi(value);
+            else if (std::strcmp(arg, "--threads") == 0) options.threads = std::atoi(value);
+            else if (std::strcmp(arg, "--verify") == 0) options.verifyGames = std::atoi(value);
+            else return false;
+        }
+        return argc % 2 == 1 && options.plies > 0 && options.beam > 0;
+    }
+
+    // Play the opening of many games with the book to measure its coverage
+    void verify(const std::string& path, int games, int plies) {
+        auto book = std::make_shared<OpeningBook>();
+        if (!book->open(path)) {
+            std::fprintf(stderr, "cannot map %s\n", path.c_str());
+            return;
+        }
+
+        BookAgent agent(book, AgentFactory::create("heuristic", 0));
+        HeuristicAgent searcher;
+        AgentPlan plan;
+        std::vector<GameEvent> events;
+        AgentBudget budget;
+        double bookSeconds = 0.0;
+        double searchSeconds = 0.0;
+        int thoughts = 0;
+
+        for (int g = 0; g < games; g++) {
+            Game game(static_cast<uint32_t>(g + 1));
+
+            for (int ply = 0; ply < plies && !game.isGameOver(); ply++) {
+                GameState state = game.getState();
+                Deadline deadline(budget, 1.0f / 60.0f);
+
+                auto started = std::chrono::steady_clock::now();
+                plan.clear();
+                searcher.think(state, deadline, plan);
+                auto searched = std::chrono::steady_clock::now();
+                plan.clear();
+                agent.think(state, deadline, plan);
+                auto played = std::chrono::steady_clock::now();
+
+                searchSeconds += std::chrono::duration<double>(searched - started).count();
+                bookSeconds += std::chrono::duration<double>(played - searched).count();
+                thoughts++;
+
+                if (plan.take(events)) {
+                    for (GameEvent event : events) {
+                        game.handleEvent(event);
+                    }
+                }
+            }
+        }
+
+        std::printf("verify: %d games, %lld of %d opening pieces from the book (%.1f%%)\n", games,
+                    agent.getHits(), thoughts, 100.0 * agent.getHits() / std::max(1, thoughts));
+        std::printf("per piece: book agent %.2f us, depth-1 heuristic search %.2f us\n",
+                    1e6 * bookSeconds / std::max(1, thoughts), 1e6 * searchSeconds / std::max(1, thoughts));
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: book_builder [--out FILE] [--plies N] [--beam N] [--threads N]\n"
+                             "                    [--verify GAMES]\n");
+        return 1;
+    }
+
+    int threads = options.threads > 0
+        ? options.threads
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    // Roots: every first piece with every preview the first bag can show
+    std::vector<std::array<TetrominoType, PREVIEW + 1>> roots;
+    for (int a = 1; a <= BAG_SIZE; a++) {
+        for (int b = 1; b <= BAG_SIZE; b++) {
+            for (int c = 1; c <= BAG_SIZE; c++) {
+                if (a == b || a == c || b == c) continue;
+                roots.push_back({static_cast<TetrominoType>(a), static_cast<TetrominoType>(b),
+                                 static_cast<TetrominoType>(c)});
+            }
+        }
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> nextRoot(0);
+    std::mutex mutex;
+    std::vector<BookEntry> entries;
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            Builder builder(options);
+            for (std::size_t r = nextRoot++; r < roots.size(); r = nextRoot++) {
+                TetrominoType opening[PREVIEW + 1];
+                std::copy(roots[r].begin(), roots[r].end(), opening);
+                builder.build(opening);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.insert(entries.end(), builder.entries.begin(), builder.entries.end());
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    std::size_t searched = entries.size();
+    if (!OpeningBook::write(options.out, entries)) {
+        std::fprintf(stderr, "cannot write %s\n", options.out.c_str());
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::printf("%zu positions searched, %zu book entries (%zu KiB) in %.1fs on %d threads -> %s\n",
+                searched, entries.size(), (entries.size() * sizeof(BookEntry) + 16) / 1024, seconds,
+                threads, options.out.c_str());
+
+    if (options.verifyGames > 0) {
+        verify(options.out, options.verifyGames, options.plies);
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Headless input latency measurement.
+//
+// Runs a Game through the same frame structure as the window front end
+// (input poll, fixed-rate ticks with timestamped inputs, draw, present,
+// wait for the next frame) while a synthetic injector presses keys at
+// random times, and reports how long inputs take to reach the engine and
+// then the screen. --max-p99-ms turns it into a pass/fail check for
+// automated runs.
+//
+//   build/tools/input_latency --seconds 10 --rate 20
+//   build/tools/input_latency --fps 144 --render-us 4000
+//   build/tools/input_latency --tick-rate 240
+//   build/tools/input_latency --seconds 3 --max-p99-ms 40
+
+#include "engine/game.hpp"
+#include "engine/input_latency.hpp"
+#include "engine/simulation_loop.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = InputLatencyProbe::Clock;
+
+    struct Options {
+        double seconds = 5.0;
+        double rate = 20.0;
+        int fps = 60;
+        int tickRate = SimulationLoop::DEFAULT_TICK_RATE;
+        int renderMicros = 2000;
+        uint32_t seed = 1;
+        double maxP99 = 0.0;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+            if (value == nullptr) {
+                return false;
+            } else if (std::strcmp(arg, "--seconds") == 0) {
+                options.seconds = std::atof(value);
+            } else if (std::strcmp(arg, "--rate") == 0) {
+                options.rate = std::atof(value);
+            } else if (std::strcmp(arg, "--fps") == 0) {
+                options.fps = std::atoi(value);
+            } else if (std::strcmp(arg, "--tick-rate") == 0) {
+                options.tickRate = std::atoi(value);
+            } else if (std::strcmp(arg, "--render-us") == 0) {
+                options.renderMicros = std::atoi(value);
+            } else if (std::strcmp(arg, "--seed") == 0) {
+                options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            } else if (std::strcmp(arg, "--max-p99-ms") == 0) {
+                options.maxP99 = std::atof(value);
+            } else {
+                return false;
+            }
+        }
+        return options.seconds > 0.0 && options.rate > 0.0 && options.fps > 0 && options.tickRate > 0;
+    }
+
+    void printUsage() {
+        std::fprintf(stderr,
+                     "usage: input_latency [--seconds N] [--rate KEYS_PER_S] [--fps N]\n"
+                     "                     [--tick-rate HZ] [--render-us N] [--seed S] [--max-p99-ms MS]\n");
+    }
+
+    // Stands in for drawing the frame: reads the state and keeps the CPU busy
+    void render(const Game& game, int micros) {
+        auto until = Clock::now() + std::chrono::microseconds(micros);
+        volatile int score = game.getState().score;
+        (void)score;
+        while (Clock::now() < until) {
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    Game game(options.seed);
+    InputLatencyProbe probe(game);
+    SimulationLoop simulation(game, options.tickRate);
+    simulation.attachLatencyProbe(&probe);
+    InputInjector injector(options.rate, options.seed);
+    std::vector<InputInjector::Input> inputs;
+
+    auto frameDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / options.fps));
+    auto started = Clock::now();
+    auto finish = started + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+    auto now = started;
+    auto nextFrame = started + frameDuration;
+    int frames = 0;
+    int ticks = 0;
+
+    while (now < finish) {
+        now = Clock::now();
+
+        // Input: everything pressed since the last poll, each at its own time
+        injector.poll(inputs);
+        for (const InputInjector::Input& input : inputs) {
+            probe.recordKey(input.event, input.pressed);
+            simulation.push(input.event, input.pressed);
+        }
+
+        ticks += simulation.advance(now);
+
+        render(game, options.renderMicros);
+        probe.recordFrame(Clock::now());
+        frames++;
+
+        // Random play tops out quickly; start over without counting it as input
+        if (game.isGameOver()) {
+            game.reset();
+            probe.recordStep(Clock::now());
+            simulation.restart(Clock::now());
+        }
+
+        // Frame limiter (SetTargetFPS)
+        std::this_thread::sleep_until(nextFrame);
+        nextFrame += frameDuration;
+        if (nextFrame < Clock::now()) {
+            nextFrame = Clock::now() + frameDuration;
+        }
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - started).count();
+    std::printf("%d frames (%.1f fps), %d ticks (%d Hz), %.1f keys/s injected, %d us render\n",
+                frames, frames / elapsed, ticks, options.tickRate, options.rate, options.renderMicros);
+    probe.report(stdout);
+
+    if (options.maxP99 > 0.0) {
+        double p99 = probe.getTotalPercentile(0.99) / 1000.0;
+        if (probe.getSampleCount() == 0 || p99 > options.maxP99) {
+            std::printf("FAIL: p99 key -> shown %.1f ms exceeds %.1f ms\n", p99, options.maxP99);
+            return 1;
+        }
+        std::printf("PASS: p99 key -> shown %.1f ms\n", p99);
+    }
+
+    return 0;
+}
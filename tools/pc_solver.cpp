@@ -0,0 +1,224 @@
+// Perfect-clear and finesse analysis.
+//
+// Looks for a sequence of placements that empties the board using the
+// known queue (current piece, preview and the rest of the generator's
+// sequence), then prints the fewest key presses for each placement and
+// replays them on a Game to check that it really ends in a perfect clear.
+//
+//   build/tools/pc_solver --seed 42                 # opening of one game
+//   build/tools/pc_solver --queue IOTLJSZIOT        # explicit queue
+//   build/tools/pc_solver --bench 200 --height 4    # timing over many seeds
+
+#include "bot/finesse.hpp"
+#include "bot/perfect_clear.hpp"
+#include "engine/game.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+    struct Options {
+        uint32_t seed = 1;
+        const char* queue = nullptr;
+        int bench = 0;
+        bool quiet = false;
+        PerfectClearConfig config;
+    };
+
+    const char PIECE_NAMES[] = ".IOTSZJLG";
+
+    bool parseQueue(const char* text, std::vector<TetrominoType>& out) {
+        out.clear();
+        for (const char* c = text; *c != '\0'; c++) {
+            const char* found = std::strchr(PIECE_NAMES + 1, *c);
+            if (found == nullptr || *c == 'G') return false;
+            out.push_back(static_cast<TetrominoType>(found - PIECE_NAMES));
+        }
+        return !out.empty();
+    }
+
+    const char* orientationName(Orientation orientation) {
+        static const char* NAMES[4] = {"N", "E", "S", "W"};
+        return NAMES[static_cast<int>(orientation)];
+    }
+
+    // The queue a Game will deal: current piece first, then the generator's sequence
+    std::vector<TetrominoType> gameQueue(const Game& game, int count) {
+        std::vector<TetrominoType> queue(count);
+        queue[0] = game.getState().currentPieceType;
+        game.peekQueue(queue.data() + 1, count - 1);
+        return queue;
+    }
+
+    // Replay a solution on the game with finesse inputs; true if it ends in a perfect clear
+    bool replay(Game& game, const PerfectClearResult& result, bool print, int& totalPresses) {
+        totalPresses = 0;
+
+        for (const PerfectClearStep& step : result.steps) {
+            if (step.hold) {
+                game.handleEvent(GameEvent::HOLD);
+                totalPresses++;
+            }
+
+            GameState state = game.getState();
+            FinessePath path;
+            if (state.currentPieceType != step.placement.type ||
+                !Finesse::findPath(state.board, step.placement, path)) {
+                return false;
+            }
+
+            for (GameEvent event : path.events) {
+                game.handleEvent(event);
+            }
+            totalPresses += path.presses;
+
+            if (print) {
+                std::printf("  %c%s at x=%d y=%d %s, %d presses\n",
+                            PIECE_NAMES[static_cast<int>(step.placement.type)], step.hold ? " (hold)" : "",
+                            step.placement.x, step.placement.y, orientationName(step.placement.orientation),
+                            path.presses);
+            }
+        }
+
+        return game.wasPerfectClear();
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+
+            if (std::strcmp(arg, "--quiet") == 0) {
+                options.quiet = true;
+                continue;
+            }
+            if (std::strcmp(arg, "--no-hold") == 0) {
+                options.config.allowHold = false;
+                continue;
+            }
+
+            const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+            if (value == nullptr) {
+                return false;
+            } else if (std::strcmp(arg, "--seed") == 0) {
+                options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            } else if (std::strcmp(arg, "--queue") == 0) {
+                options.queue = value;
+            } else if (std::strcmp(arg, "--bench") == 0) {
+                options.bench = std::atoi(value);
+            } else if (std::strcmp(arg, "--height") == 0) {
+                options.config.maxHeight = std::atoi(value);
+            } else if (std::strcmp(arg, "--pieces") == 0) {
+                options.config.maxPieces = std::atoi(value);
+            } else if (std::strcmp(arg, "--threads") == 0) {
+                options.config.threads = std::atoi(value);
+            } else {
+                return false;
+            }
+        }
+        return options.config.maxPieces > 0;
+    }
+
+    void printUsage() {
+        std::fprintf(stderr,
+                     "usage: pc_solver [--seed S | --queue PIECES] [--height H] [--pieces N]\n"
+                     "                 [--threads N] [--no-hold] [--bench GAMES] [--quiet]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // One extra piece so a hold into an empty slot can still reach the last one
+    int queueLength = options.config.maxPieces + 1;
+
+    if (options.bench > 0) {
+        std::vector<double> times;
+        int solved = 0;
+        int verified = 0;
+        uint64_t nodes = 0;
+
+        for (int g = 0; g < options.bench; g++) {
+            Game game(options.seed + static_cast<uint32_t>(g));
+            GameState state = game.getState();
+
+            PerfectClearResult result;
+            auto started = std::chrono::steady_clock::now();
+            PerfectClearSolver::solve(state.board, gameQueue(game, queueLength), state.heldPieceType,
+                                      options.config, result);
+            times.push_back(std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - started).count());
+            nodes += result.nodes;
+
+            int presses;
+            if (result.found) {
+                solved++;
+                if (replay(game, result, false, presses)) verified++;
+            }
+        }
+
+        std::sort(times.begin(), times.end());
+        double total = 0.0;
+        for (double t : times) total += t;
+
+        std::printf("%d openings: %d perfect clears (%d verified by replay), %.0f nodes/solve\n",
+                    options.bench, solved, verified, static_cast<double>(nodes) / options.bench);
+        std::printf("solve time ms: mean %.2f, median %.2f, p95 %.2f, max %.2f\n",
+                    total / times.size(), times[times.size() / 2], times[times.size() * 95 / 100],
+                    times.back());
+        return 0;
+    }
+
+    Game game(options.seed);
+    std::vector<TetrominoType> queue;
+
+    if (options.queue != nullptr) {
+        if (!parseQueue(options.queue, queue)) {
+            std::fprintf(stderr, "queue must use the letters IOTSZJL\n");
+            return 1;
+        }
+    } else {
+        queue = gameQueue(game, queueLength);
+    }
+
+    GameState state = game.getState();
+    PerfectClearResult result;
+    auto started = std::chrono::steady_clock::now();
+    PerfectClearSolver::solve(state.board, queue, TetrominoType::NONE, options.config, result);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    std::printf("queue ");
+    for (TetrominoType type : queue) std::putchar(PIECE_NAMES[static_cast<int>(type)]);
+    std::printf("\n");
+
+    if (!result.found) {
+        std::printf("no perfect clear within %d rows and %d pieces (%llu nodes, %.2f ms)\n",
+                    options.config.maxHeight, options.config.maxPieces,
+                    static_cast<unsigned long long>(result.nodes), ms);
+        return 2;
+    }
+
+    std::printf("%d-row perfect clear in %zu pieces (%llu nodes, %.2f ms)\n", result.height,
+                result.steps.size(), static_cast<unsigned long long>(result.nodes), ms);
+
+    // Replaying needs the game to deal the same queue
+    if (options.queue != nullptr) {
+        for (const PerfectClearStep& step : result.steps) {
+            std::printf("  %c%s at x=%d y=%d %s\n", PIECE_NAMES[static_cast<int>(step.placement.type)],
+                        step.hold ? " (hold)" : "", step.placement.x, step.placement.y,
+                        orientationName(step.placement.orientation));
+        }
+        return 0;
+    }
+
+    int presses;
+    bool cleared = replay(game, result, !options.quiet, presses);
+    std::printf("replay: %s, %d presses\n", cleared ? "perfect clear" : "FAILED", presses);
+    return cleared ? 0 : 3;
+}
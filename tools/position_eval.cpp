@@ -0,0 +1,143 @@
+// Monte Carlo position analysis.
+//
+// Builds a position by letting the policy play the first pieces of a
+// seeded game (or starts from the empty board), then runs randomized
+// rollouts from it across all cores and reports expected lines cleared,
+// survival probability and the score distribution over the horizon.
+//
+//   build/tools/position_eval --seed 7 --setup 12
+//   build/tools/position_eval --rollouts 10000 --horizon 20 --policy stacker
+//   build/tools/position_eval --setup 30 --threads 1
+
+#include "bot/agent_factory.hpp"
+#include "bot/rollout.hpp"
+#include "engine/game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+    const char PIECE_NAMES[] = ".IOTSZJLG";
+
+    struct Options {
+        uint32_t seed = 1;
+        int setup = 0;
+        RolloutConfig config;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+            if (value == nullptr) {
+                return false;
+            } else if (std::strcmp(arg, "--seed") == 0) {
+                options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+                options.config.seed = options.seed;
+            } else if (std::strcmp(arg, "--setup") == 0) {
+                options.setup = std::atoi(value);
+            } else if (std::strcmp(arg, "--rollouts") == 0) {
+                options.config.rollouts = std::atoi(value);
+            } else if (std::strcmp(arg, "--horizon") == 0) {
+                options.config.maxPieces = std::atoi(value);
+            } else if (std::strcmp(arg, "--policy") == 0) {
+                options.config.policy = value;
+            } else if (std::strcmp(arg, "--budget-us") == 0) {
+                options.config.budget.microseconds = std::atoll(value);
+            } else if (std::strcmp(arg, "--threads") == 0) {
+                options.config.threads = std::atoi(value);
+            } else {
+                return false;
+            }
+        }
+        return options.config.rollouts > 0 && options.config.maxPieces > 0 && options.setup >= 0;
+    }
+
+    void printUsage() {
+        std::fprintf(stderr,
+                     "usage: position_eval [--seed S] [--setup PIECES] [--rollouts K] [--horizon PIECES]\n"
+                     "                     [--policy NAME] [--budget-us N] [--threads N]\n");
+    }
+
+    // Play the opening with the policy itself to reach a realistic position
+    bool setUp(Game& game, const RolloutConfig& config, int pieces) {
+        std::unique_ptr<IAgent> agent = AgentFactory::create(config.policy, static_cast<uint32_t>(config.seed));
+        AgentPlan plan;
+        std::vector<GameEvent> events;
+
+        for (int p = 0; p < pieces && !game.isGameOver(); p++) {
+            Deadline deadline(config.budget, 1.0f / 60.0f);
+            plan.clear();
+            agent->think(game.getState(), deadline, plan);
+            if (!plan.take(events)) {
+                return false;
+            }
+            for (GameEvent event : events) {
+                game.handleEvent(event);
+            }
+        }
+        return !game.isGameOver();
+    }
+
+    void printPosition(const Game& game) {
+        GameState state = game.getState();
+        TetrominoType queue[5];
+        game.peekQueue(queue, 5);
+
+        std::printf("current %c  hold %c  next ", PIECE_NAMES[static_cast<int>(state.currentPieceType)],
+                    PIECE_NAMES[static_cast<int>(state.heldPieceType)]);
+        for (TetrominoType type : queue) {
+            std::printf("%c", PIECE_NAMES[static_cast<int>(type)]);
+        }
+        std::printf("  (score %d, lines %d)\n", state.score, state.linesCleared);
+
+        for (int row = 0; row < 20; row++) {
+            bool empty = true;
+            for (int col = 0; col < 10; col++) {
+                empty = empty && state.board[row][col] == 0;
+            }
+            if (empty && row < 19) continue;
+
+            std::printf("  |");
+            for (int col = 0; col < 10; col++) {
+                std::printf("%c", state.board[row][col] != 0 ? '#' : '.');
+            }
+            std::printf("|\n");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (AgentFactory::create(options.config.policy, 0) == nullptr) {
+        std::fprintf(stderr, "unknown policy %s\n", options.config.policy.c_str());
+        return 1;
+    }
+
+    Game position(options.seed);
+    if (!setUp(position, options.config, options.setup)) {
+        std::fprintf(stderr, "the policy topped out while setting up the position\n");
+        return 1;
+    }
+    printPosition(position);
+
+    RolloutResult result;
+    RolloutAnalyzer::analyze(position, options.config, result);
+
+    std::printf("%d rollouts of %d pieces (%s) in %.3f s, %.0f pieces/s\n", result.rollouts,
+                options.config.maxPieces, options.config.policy.c_str(), result.seconds,
+                result.pieces / result.seconds);
+    std::printf("expected lines %.3f, survival %.2f%%, mean score %.1f\n", result.expectedLines,
+                result.survivalRate * 100.0, result.meanScore);
+    std::printf("score p10 %d  p25 %d  p50 %d  p75 %d  p90 %d  max %d\n",
+                result.getScorePercentile(0.1), result.getScorePercentile(0.25),
+                result.getScorePercentile(0.5), result.getScorePercentile(0.75),
+                result.getScorePercentile(0.9), result.getScorePercentile(1.0));
+    return 0;
+}
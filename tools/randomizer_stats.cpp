@@ -0,0 +1,294 @@
+// Piece-sequence statistics for the randomizers PieceGenerator supports.
+//
+// Every thread draws its own stream straight from the randomizer type (a
+// template instantiation per strategy, so nothing is dispatched per piece)
+// and folds each piece into fixed-size counters as it goes: memory does
+// not grow with the sample count. Reported per strategy:
+//
+//   - piece frequencies with a chi-square test against 1/7 each (fairness)
+//   - pair and triple frequencies with chi-square against independent
+//     uniform draws (how predictable the sequence is; bags are by design)
+//   - droughts: pieces from one occurrence of a type to the next
+//
+//   build/tools/randomizer_stats                          # 1e9 pieces each
+//   build/tools/randomizer_stats --pieces 10000000000 --randomizer 7bag
+//   build/tools/randomizer_stats --pieces 100000000 --threads 1
+
+#include "engine/piece_generator.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int TYPES = 7;
+    // Longer droughts share the last bucket (the maximum is kept exactly)
+    constexpr int MAX_INTERVAL = 256;
+    constexpr int TRIPLES = TYPES * TYPES * TYPES;
+
+    struct Options {
+        uint64_t pieces = 1000000000ull;
+        int threads = 0;
+        uint64_t seed = 1;
+        bool all = true;
+        RandomizerKind kind = RandomizerKind::SEVEN_BAG;
+    };
+
+    struct alignas(64) SequenceStats {
+        uint64_t pieces = 0;
+        // Consecutive triples, indexed (a * 7 + b) * 7 + c
+        std::array<uint64_t, TRIPLES> triples = {};
+        // The first two pieces of each stream, which start no triple
+        std::array<uint64_t, TYPES> heads = {};
+        std::array<uint64_t, TYPES * TYPES> headPairs = {};
+        std::array<uint64_t, MAX_INTERVAL + 1> intervals = {};
+        uint64_t maxInterval = 0;
+
+        void merge(const SequenceStats& other) {
+            this->pieces += other.pieces;
+            for (std::size_t i = 0; i < this->triples.size(); i++) this->triples[i] += other.triples[i];
+            for (std::size_t i = 0; i < this->heads.size(); i++) this->heads[i] += other.heads[i];
+            for (std::size_t i = 0; i < this->headPairs.size(); i++) this->headPairs[i] += other.headPairs[i];
+            for (std::size_t i = 0; i < this->intervals.size(); i++) this->intervals[i] += other.intervals[i];
+            this->maxInterval = std::max(this->maxInterval, other.maxInterval);
+        }
+    };
+
+    uint64_t streamSeed(uint64_t seed, uint64_t index) {
+        uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // The hot loop, inlined for the concrete randomizer type. Pieces are
+    // drawn a block at a time and then counted, so the counters never wait
+    // on the random stream and no update depends on the previous one.
+    template <typename R>
+    void collect(uint64_t seed, uint64_t count, SequenceStats& stats) {
+        constexpr int BLOCK = 4096;
+
+        R randomizer;
+        Pcg32 rng;
+        rng.seed(seed);
+
+        // Two pieces carried over from the previous block, then the block
+        uint8_t pieces[BLOCK + 2];
+        // Position (1-based) of each type's last occurrence, 0 = not seen yet
+        uint64_t last[TYPES] = {};
+        uint64_t maxInterval = 0;
+        uint64_t position = 0;
+
+        while (position < count) {
+            int size = static_cast<int>(std::min<uint64_t>(BLOCK, count - position));
+            for (int i = 0; i < size; i++) {
+                pieces[2 + i] = static_cast<uint8_t>(static_cast<int>(randomizer.next(rng)) - 1);
+            }
+
+            // The first two pieces of the stream start no triple
+            int first = 0;
+            if (position == 0) {
+                first = std::min(2, size);
+                for (int i = 0; i < first; i++) stats.heads[pieces[2 + i]]++;
+                if (size >= 2) stats.headPairs[pieces[2] * TYPES + pieces[3]]++;
+            }
+            for (int i = first; i < size; i++) {
+                stats.triples[(pieces[i] * TYPES + pieces[i + 1]) * TYPES + pieces[i + 2]]++;
+            }
+
+            for (int i = 0; i < size; i++) {
+                int type = pieces[2 + i];
+                uint64_t current = position + static_cast<uint64_t>(i) + 1;
+                if (last[type] != 0) {
+                    uint64_t interval = current - last[type];
+                    maxInterval = std::max(maxInterval, interval);
+                    stats.intervals[std::min<uint64_t>(interval, MAX_INTERVAL)]++;
+                }
+                last[type] = current;
+            }
+
+            position += static_cast<uint64_t>(size);
+            pieces[0] = pieces[size];
+            pieces[1] = pieces[size + 1];
+        }
+
+        stats.pieces = count;
+        stats.maxInterval = maxInterval;
+    }
+
+    void collect(RandomizerKind kind, uint64_t seed, uint64_t count, SequenceStats& stats) {
+        switch (kind) {
+            case RandomizerKind::SEVEN_BAG: collect<SevenBagRandomizer>(seed, count, stats); break;
+            case RandomizerKind::FOURTEEN_BAG: collect<FourteenBagRandomizer>(seed, count, stats); break;
+            case RandomizerKind::HISTORY: collect<HistoryRandomizer>(seed, count, stats); break;
+            case RandomizerKind::RANDOM: collect<UniformRandomizer>(seed, count, stats); break;
+        }
+    }
+
+    struct ChiSquare {
+        double value;
+        int degrees;
+        // Wilson-Hilferty normal approximation; |z| < 3 is consistent with the model
+        double z;
+    };
+
+    ChiSquare chiSquare(const uint64_t* observed, int cells) {
+        uint64_t total = 0;
+        for (int i = 0; i < cells; i++) total += observed[i];
+
+        double expected = static_cast<double>(total) / cells;
+        double value = 0.0;
+        for (int i = 0; i < cells; i++) {
+            double difference = static_cast<double>(observed[i]) - expected;
+            value += difference * difference / expected;
+        }
+
+        int degrees = cells - 1;
+        double scale = 2.0 / (9.0 * degrees);
+        double z = (std::cbrt(value / degrees) - (1.0 - scale)) / std::sqrt(scale);
+        return {value, degrees, z};
+    }
+
+    uint64_t intervalPercentile(const SequenceStats& stats, double quantile) {
+        uint64_t total = 0;
+        for (uint64_t count : stats.intervals) total += count;
+
+        uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(total));
+        uint64_t seen = 0;
+        for (int i = 1; i <= MAX_INTERVAL; i++) {
+            seen += stats.intervals[i];
+            if (seen > rank) return static_cast<uint64_t>(i);
+        }
+        return MAX_INTERVAL;
+    }
+
+    void report(RandomizerKind kind, const SequenceStats& stats, double seconds, int threads) {
+        std::array<uint64_t, TYPES> singles = stats.heads;
+        std::array<uint64_t, TYPES * TYPES> pairs = stats.headPairs;
+        for (int window = 0; window < TRIPLES; window++) {
+            singles[window % TYPES] += stats.triples[window];
+            pairs[window % (TYPES * TYPES)] += stats.triples[window];
+        }
+
+        uint64_t pairTotal = 0;
+        uint64_t repeats = 0;
+        for (int i = 0; i < TYPES; i++) repeats += pairs[i * TYPES + i];
+        for (uint64_t count : pairs) pairTotal += count;
+
+        uint64_t intervalTotal = 0;
+        double intervalSum = 0.0;
+        for (int i = 1; i <= MAX_INTERVAL; i++) {
+            intervalTotal += stats.intervals[i];
+            intervalSum += static_cast<double>(i) * stats.intervals[i];
+        }
+
+        ChiSquare one = chiSquare(singles.data(), TYPES);
+        ChiSquare two = chiSquare(pairs.data(), TYPES * TYPES);
+        ChiSquare three = chiSquare(stats.triples.data(), TRIPLES);
+
+        std::printf("%s: %llu pieces in %.2f s (%.0f M/s, %.0f M/s per thread)\n",
+                    PieceGenerator::getRandomizerName(kind), static_cast<unsigned long long>(stats.pieces),
+                    seconds, stats.pieces / seconds / 1e6, stats.pieces / seconds / 1e6 / threads);
+
+        std::printf("  frequency ");
+        const char names[] = "IOTSZJL";
+        for (int i = 0; i < TYPES; i++) {
+            std::printf(" %c %.5f", names[i], static_cast<double>(singles[i]) / stats.pieces);
+        }
+        std::printf("\n");
+        std::printf("  chi-square singles %.1f (df %d, z %+.2f)  pairs %.1f (df %d, z %+.2f)  triples %.1f (df %d, z %+.2f)\n",
+                    one.value, one.degrees, one.z, two.value, two.degrees, two.z, three.value, three.degrees,
+                    three.z);
+        std::printf("  same piece twice %.5f (independent draws: %.5f)\n",
+                    pairTotal > 0 ? static_cast<double>(repeats) / pairTotal : 0.0, 1.0 / TYPES);
+        std::printf("  drought mean %.3f  p50 %llu  p99 %llu  p99.99 %llu  max %llu\n",
+                    intervalTotal > 0 ? intervalSum / intervalTotal : 0.0,
+                    static_cast<unsigned long long>(intervalPercentile(stats, 0.5)),
+                    static_cast<unsigned long long>(intervalPercentile(stats, 0.99)),
+                    static_cast<unsigned long long>(intervalPercentile(stats, 0.9999)),
+                    static_cast<unsigned long long>(stats.maxInterval));
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+            if (value == nullptr) {
+                return false;
+            } else if (std::strcmp(arg, "--pieces") == 0) {
+                options.pieces = std::strtoull(value, nullptr, 10);
+            } else if (std::strcmp(arg, "--threads") == 0) {
+                options.threads = std::atoi(value);
+            } else if (std::strcmp(arg, "--seed") == 0) {
+                options.seed = std::strtoull(value, nullptr, 10);
+            } else if (std::strcmp(arg, "--randomizer") == 0) {
+                options.all = std::strcmp(value, "all") == 0;
+                if (!options.all && !PieceGenerator::parseRandomizer(value, options.kind)) {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+        }
+        return options.pieces > 0;
+    }
+
+    void printUsage() {
+        std::fprintf(stderr,
+                     "usage: randomizer_stats [--pieces N] [--threads N] [--seed S]\n"
+                     "                        [--randomizer all|7bag|14bag|history|random]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    int threadCount = options.threads > 0 ? options.threads
+                                           : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<RandomizerKind> kinds;
+    if (options.all) {
+        kinds = {RandomizerKind::SEVEN_BAG, RandomizerKind::FOURTEEN_BAG, RandomizerKind::HISTORY,
+                 RandomizerKind::RANDOM};
+    } else {
+        kinds = {options.kind};
+    }
+
+    for (RandomizerKind kind : kinds) {
+        std::vector<SequenceStats> partial(threadCount);
+        auto started = std::chrono::steady_clock::now();
+
+        // One independent stream per thread, its share of the pieces each
+        auto worker = [&](int thread) {
+            uint64_t share = options.pieces / threadCount + (static_cast<uint64_t>(thread) < options.pieces % threadCount ? 1 : 0);
+            collect(kind, streamSeed(options.seed, static_cast<uint64_t>(thread)), share, partial[thread]);
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < threadCount; t++) {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        SequenceStats total;
+        for (const SequenceStats& stats : partial) {
+            total.merge(stats);
+        }
+        report(kind, total, seconds, threadCount);
+    }
+    return 0;
+}
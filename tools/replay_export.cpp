@@ -0,0 +1,267 @@
+// Offline video export of recorded games, much faster than real time.
+//
+// Plays replays (from `tetris --record FILE`, or bot games recorded on the
+// fly) tick by tick and draws every frame with the Renderer's layout
+// through the software rasterizer: no window, no GPU. Frames are rendered
+// on all cores and written in order as raw RGBA, to a file, stdout or an
+// encoder's stdin.
+//
+//   build/tools/replay_export --replay game.replay --out game.rgba
+//   build/tools/replay_export --agent heuristic --games 100
+//       --pipe "ffmpeg -f rawvideo -pix_fmt rgba -s 800x670 -r 60 -i - reel.mp4"
+//   build/tools/replay_export --agent heuristic --games 10 --save-prefix reel_
+//
+// Without --out or --pipe the frames are rendered and dropped (a benchmark).
+
+#include "bot/agent_factory.hpp"
+#include "engine/replay.hpp"
+#include "video/frame_pipeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    // As long as the Renderer's line clear flash
+    constexpr float CLEAR_FLASH_TIME = 0.25f;
+
+    struct Options {
+        std::vector<std::string> replays;
+        std::string agent;
+        int games = 1;
+        uint32_t seed = 1;
+        int maxPieces = 200;
+        int inputTicks = 4;
+        bool competitive = false;
+        std::string savePrefix;
+
+        std::string outPath;
+        std::string pipeCommand;
+        int fps = 0;
+        int threads = 0;
+        float tailSeconds = 1.0f;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            if (std::strcmp(arg, "--competitive") == 0) {
+                options.competitive = true;
+                continue;
+            }
+
+            const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+            if (value == nullptr) {
+                return false;
+            } else if (std::strcmp(arg, "--replay") == 0) {
+                options.replays.push_back(value);
+            } else if (std::strcmp(arg, "--agent") == 0) {
+                options.agent = value;
+            } else if (std::strcmp(arg, "--games") == 0) {
+                options.games = std::atoi(value);
+            } else if (std::strcmp(arg, "--seed") == 0) {
+                options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            } else if (std::strcmp(arg, "--max-pieces") == 0) {
+                options.maxPieces = std::atoi(value);
+            } else if (std::strcmp(arg, "--input-ticks") == 0) {
+                options.inputTicks = std::max(1, std::atoi(value));
+            } else if (std::strcmp(arg, "--save-prefix") == 0) {
+                options.savePrefix = value;
+            } else if (std::strcmp(arg, "--out") == 0) {
+                options.outPath = value;
+            } else if (std::strcmp(arg, "--pipe") == 0) {
+                options.pipeCommand = value;
+            } else if (std::strcmp(arg, "--fps") == 0) {
+                options.fps = std::atoi(value);
+            } else if (std::strcmp(arg, "--threads") == 0) {
+                options.threads = std::atoi(value);
+            } else if (std::strcmp(arg, "--tail") == 0) {
+                options.tailSeconds = static_cast<float>(std::atof(value));
+            } else {
+                return false;
+            }
+        }
+        return (!options.replays.empty() || !options.agent.empty()) && options.games > 0 &&
+               options.fps >= 0 && (options.outPath.empty() || options.pipeCommand.empty());
+    }
+
+    void printUsage() {
+        std::fprintf(stderr,
+                     "usage: replay_export (--replay FILE ... | --agent NAME [--games N] [--seed S]\n"
+                     "                     [--max-pieces N] [--input-ticks N] [--competitive] [--save-prefix P])\n"
+                     "                     [--out FILE|- | --pipe CMD] [--fps N] [--threads N] [--tail SECONDS]\n");
+    }
+
+    // A bot game played tick by tick at a watchable pace: the agent decides
+    // when a piece spawns, then its inputs go in one every few ticks
+    bool recordAgentGame(const Options& options, uint32_t seed, Replay& replay) {
+        std::unique_ptr<IAgent> agent = AgentFactory::create(options.agent, seed);
+        if (agent == nullptr) {
+            return false;
+        }
+
+        Game game(seed, options.competitive ? GameRules::competitive() : GameRules());
+        ReplayRecorder recorder(game, game, 60);
+        AgentPlan plan;
+        std::vector<GameEvent> planned;
+        std::deque<GameEvent> pending;
+        int thinkingPiece = -1;
+
+        while (!game.isGameOver() && game.getPiecesLocked() < options.maxPieces) {
+            if (pending.empty() && game.getPiecesLocked() != thinkingPiece) {
+                thinkingPiece = game.getPiecesLocked();
+                plan.clear();
+                agent->think(game.getState(), Deadline(AgentBudget(), 1.0f / 60.0f), plan);
+                if (plan.take(planned)) {
+                    pending.assign(planned.begin(), planned.end());
+                }
+            }
+            if (!pending.empty() && recorder.getReplay().ticks % options.inputTicks == 0) {
+                recorder.handleEvent(pending.front());
+                pending.pop_front();
+            }
+            recorder.update(1.0f / 60.0f);
+        }
+
+        replay = recorder.getReplay();
+        return true;
+    }
+
+    // Step one replay and queue a frame for every 1/fps of game time
+    bool exportReplay(const Replay& replay, const Options& options, FramePipeline& pipeline) {
+        int fps = options.fps > 0 ? options.fps : replay.tickRate;
+        float frameTime = 1.0f / static_cast<float>(fps);
+        int tailFrames = static_cast<int>(options.tailSeconds * fps);
+
+        ReplayPlayer player(replay);
+        uint64_t cursor = player.getGame().getEventCursor();
+        FrameInfo frame;
+        float flashTimer = 0.0f;
+        EngineEvent events[16];
+
+        for (int64_t f = 0; tailFrames > 0; f++) {
+            int64_t tick = f * replay.tickRate / fps;
+            while (player.getTick() < tick && player.step()) {
+            }
+
+            int count;
+            while ((count = player.getGame().readEvents(cursor, events, 16)) > 0) {
+                for (int i = 0; i < count; i++) {
+                    if (events[i].type != EngineEventType::LINES_CLEARED) continue;
+
+                    flashTimer = CLEAR_FLASH_TIME;
+                    frame.clearFlashCount = 0;
+                    for (int bit = 0; bit < 4; bit++) {
+                        if (events[i].value & (1 << bit)) {
+                            frame.clearFlashRows[frame.clearFlashCount++] = events[i].y - bit;
+                        }
+                    }
+                }
+            }
+            flashTimer -= frameTime;
+
+            frame.state = player.getGame().getState();
+            frame.clearFlash = std::max(0.0f, flashTimer / CLEAR_FLASH_TIME);
+            if (!pipeline.push(frame)) {
+                return false;
+            }
+
+            if (player.isFinished()) {
+                tailFrames--;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<Replay> replays(options.replays.size());
+    for (std::size_t i = 0; i < options.replays.size(); i++) {
+        if (!replays[i].load(options.replays[i])) {
+            std::fprintf(stderr, "cannot read replay %s\n", options.replays[i].c_str());
+            return 1;
+        }
+    }
+    if (!options.agent.empty() && AgentFactory::create(options.agent, 0) == nullptr) {
+        std::fprintf(stderr, "unknown agent %s\n", options.agent.c_str());
+        return 1;
+    }
+
+    std::FILE* output = nullptr;
+    bool piped = false;
+    if (options.outPath == "-") {
+        output = stdout;
+    } else if (!options.outPath.empty()) {
+        output = std::fopen(options.outPath.c_str(), "wb");
+    } else if (!options.pipeCommand.empty()) {
+        output = popen(options.pipeCommand.c_str(), "w");
+        piped = true;
+    }
+    if ((!options.outPath.empty() || piped) && output == nullptr) {
+        std::fprintf(stderr, "cannot open output\n");
+        return 1;
+    }
+
+    FrameRasterizer rasterizer;
+    FramePipeline pipeline(rasterizer, options.threads, [output](const uint8_t* pixels, std::size_t bytes) {
+        return output == nullptr || std::fwrite(pixels, 1, bytes, output) == bytes;
+    });
+
+    auto started = std::chrono::steady_clock::now();
+    double gameSeconds = 0.0;
+    int exported = 0;
+    bool ok = true;
+
+    for (std::size_t i = 0; i < replays.size() && ok; i++) {
+        ok = exportReplay(replays[i], options, pipeline);
+        gameSeconds += static_cast<double>(replays[i].ticks) / replays[i].tickRate;
+        exported++;
+    }
+
+    // Bot games are recorded just before they are drawn, one at a time
+    for (int g = 0; g < options.games && !options.agent.empty() && ok; g++) {
+        uint32_t seed = options.seed + static_cast<uint32_t>(g);
+        Replay replay;
+        recordAgentGame(options, seed, replay);
+        if (!options.savePrefix.empty()) {
+            std::string path = options.savePrefix + std::to_string(seed) + ".replay";
+            if (!replay.save(path)) {
+                std::fprintf(stderr, "cannot write %s\n", path.c_str());
+            }
+        }
+
+        ok = exportReplay(replay, options, pipeline);
+        gameSeconds += static_cast<double>(replay.ticks) / replay.tickRate;
+        exported++;
+    }
+
+    ok = pipeline.finish() && ok;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    if (output != nullptr && output != stdout) {
+        ok = (piped ? pclose(output) == 0 : std::fclose(output) == 0) && ok;
+    } else if (output == stdout) {
+        ok = std::fflush(stdout) == 0 && ok;
+    }
+
+    uint64_t frames = pipeline.getFramesWritten();
+    std::fprintf(stderr, "%d games, %llu frames of %dx%d in %.2f s: %.0f frames/s, %.1fx real time\n",
+                 exported, static_cast<unsigned long long>(frames), rasterizer.getWidth(),
+                 rasterizer.getHeight(), seconds, frames / seconds, gameSeconds / seconds);
+    if (!ok) {
+        std::fprintf(stderr, "output failed\n");
+        return 1;
+    }
+    return 0;
+}
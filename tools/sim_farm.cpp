@@ -0,0 +1,357 @@
+// Runs thousands of bot games in one process as C++20 coroutines.
+//
+// Each game-plus-agent loop is a coroutine that suspends at every tick
+// boundary and whenever it waits for its agent to think. A pool of worker
+// threads (one per core) resumes them from a single FIFO run queue, so all
+// games make progress at the same rate and a game costs its Game, its agent
+// and one coroutine frame instead of a thread stack. Games live in a
+// GamePool and later rounds reset them in place.
+//
+//   build/tools/sim_farm --games 20000 --agent heuristic --max-pieces 200
+//
+// Built with -std=c++20 (see TOOL_STD_sim_farm in the Makefile).
+
+#include "bot/agent_factory.hpp"
+#include "bot/book_agent.hpp"
+#include "engine/game_pool.hpp"
+#include "engine/metrics.hpp"
+#include "net/metrics_exporter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Farm-level metrics (the engine counts ticks, inputs, pieces and games itself)
+    Metrics::Histogram& TICK_SECONDS = Metrics::global().histogram(
+        "tetris_tick_seconds", "Wall time of one Game::update");
+    Metrics::Histogram& THINK_SECONDS = Metrics::global().histogram(
+        "tetris_agent_think_seconds", "Wall time of one agent decision");
+    Metrics::Gauge& GAMES_ACTIVE = Metrics::global().gauge(
+        "tetris_games_active", "Games currently being played");
+    Metrics::Gauge& QUEUE_DEPTH = Metrics::global().gauge(
+        "tetris_scheduler_queue_depth", "Runnable games and agent work waiting for a worker");
+
+    // Fire-and-forget coroutine; the frame frees itself when the body ends
+    struct GameTask {
+        struct promise_type {
+            GameTask get_return_object() {
+                return {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    class Scheduler {
+    private:
+        // A runnable coroutine, optionally with work to do before resuming it
+        struct WorkItem {
+            std::coroutine_handle<> handle;
+            void (*work)(void*);
+            void* context;
+        };
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<WorkItem> queue;
+        std::vector<std::thread> workers;
+        std::atomic<int> liveTasks;
+        bool stopping;
+
+        void push(const WorkItem& item) {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->queue.push_back(item);
+            }
+            QUEUE_DEPTH.add(1);
+            this->wake.notify_one();
+        }
+
+        void workerLoop() {
+            while (true) {
+                WorkItem item;
+                {
+                    std::unique_lock<std::mutex> lock(this->mutex);
+                    this->wake.wait(lock, [this]() { return this->stopping || !this->queue.empty(); });
+                    if (this->queue.empty()) {
+                        return;
+                    }
+                    item = this->queue.front();
+                    this->queue.pop_front();
+                }
+                QUEUE_DEPTH.sub(1);
+
+                if (item.work != nullptr) {
+                    item.work(item.context);
+                }
+                item.handle.resume();
+            }
+        }
+
+    public:
+        Scheduler() : liveTasks(0), stopping(false) {}
+
+        void spawn(GameTask task) {
+            this->liveTasks.fetch_add(1, std::memory_order_relaxed);
+            this->push({task.handle, nullptr, nullptr});
+        }
+
+        void taskFinished() {
+            if (this->liveTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->stopping = true;
+                this->wake.notify_all();
+            }
+        }
+
+        // Resume every spawned task until all of them have finished
+        void run(int threads) {
+            if (this->liveTasks.load() == 0) {
+                return;
+            }
+            for (int t = 0; t < threads; t++) {
+                this->workers.emplace_back(&Scheduler::workerLoop, this);
+            }
+            for (std::thread& worker : this->workers) {
+                worker.join();
+            }
+        }
+
+        // co_await: give the other games a turn before the next tick
+        auto nextTick() {
+            struct Awaiter {
+                Scheduler& scheduler;
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle) {
+                    scheduler.push({handle, nullptr, nullptr});
+                }
+                void await_resume() const noexcept {}
+            };
+            return Awaiter{*this};
+        }
+
+        // co_await: queue the agent's thinking as its own work item, resume after it
+        template <typename Work>
+        auto compute(Work& work) {
+            struct Awaiter {
+                Scheduler& scheduler;
+                Work& work;
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle) {
+                    scheduler.push({handle, [](void* context) { (*static_cast<Work*>(context))(); }, &work});
+                }
+                void await_resume() const noexcept {}
+            };
+            return Awaiter{*this, work};
+        }
+    };
+
+    struct Options {
+        int games = 10000;
+        int rounds = 1;
+        int threads = 0;
+        std::string agent = "heuristic";
+        int maxPieces = 200;
+        int64_t budgetMicroseconds = 0;
+        uint32_t seed = 1;
+        std::string book;
+        int metricsPort = 0;
+        std::string metricsFile;
+    };
+
+    struct GameResult {
+        int games;
+        int ticks;
+        int piecesLocked;
+        int linesCleared;
+        int score;
+        int toppedOut;
+    };
+
+    constexpr float TICK_DELTA = 1.0f / 60.0f;
+
+    GameTask playGames(Scheduler& scheduler, Game& game, IAgent& agent, const Options& options,
+                       GameResult& result) {
+        AgentPlan plan;
+        GameState state;
+        std::vector<GameEvent> events;
+        AgentBudget budget;
+        budget.microseconds = options.budgetMicroseconds;
+
+        auto think = [&]() {
+            Deadline deadline(budget, TICK_DELTA);
+            plan.clear();
+            agent.think(state, deadline, plan);
+            THINK_SECONDS.observe(std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - deadline.getStart()).count());
+        };
+
+        result = {};
+        GAMES_ACTIVE.add(1);
+
+        for (int round = 0; round < options.rounds; round++) {
+            if (round > 0) {
+                game.reset();
+            }
+
+            int plannedPiece = -1;
+
+            while (!game.isGameOver() && game.getPiecesLocked() < options.maxPieces) {
+                if (game.getPiecesLocked() != plannedPiece) {
+                    plannedPiece = game.getPiecesLocked();
+                    state = game.getState();
+
+                    co_await scheduler.compute(think);
+
+                    if (plan.take(events)) {
+                        for (GameEvent event : events) {
+                            game.handleEvent(event);
+                        }
+                    }
+                }
+
+                auto tickStart = std::chrono::steady_clock::now();
+                game.update(TICK_DELTA);
+                TICK_SECONDS.observe(std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - tickStart).count());
+                result.ticks++;
+
+                co_await scheduler.nextTick();
+            }
+
+            state = game.getState();
+            result.games++;
+            result.piecesLocked += state.piecesLocked;
+            result.linesCleared += state.linesCleared;
+            result.score += state.score;
+            result.toppedOut += state.gameOver ? 1 : 0;
+        }
+
+        GAMES_ACTIVE.sub(1);
+        scheduler.taskFinished();
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const char* arg = argv[i];
+            const char* value = argv[i + 1];
+
+            if (std::strcmp(arg, "--games") == 0) options.games = std::atoi(value);
+            else if (std::strcmp(arg, "--rounds") == 0) options.rounds = std::atoi(value);
+            else if (std::strcmp(arg, "--threads") == 0) options.threads = std::atoi(value);
+            else if (std::strcmp(arg, "--agent") == 0) options.agent = value;
+            else if (std::strcmp(arg, "--max-pieces") == 0) options.maxPieces = std::atoi(value);
+            else if (std::strcmp(arg, "--budget-us") == 0) options.budgetMicroseconds = std::atoll(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (std::strcmp(arg, "--book") == 0) options.book = value;
+            else if (std::strcmp(arg, "--metrics-port") == 0) options.metricsPort = std::atoi(value);
+            else if (std::strcmp(arg, "--metrics-file") == 0) options.metricsFile = value;
+            else return false;
+        }
+        return argc % 2 == 1 && options.games > 0 && options.rounds > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: sim_farm [--games N] [--rounds N] [--threads N] [--agent NAME]\n"
+                             "                [--max-pieces N] [--budget-us N] [--seed S] [--book FILE]\n"
+                             "                [--metrics-port PORT] [--metrics-file PATH]\n");
+        return 1;
+    }
+
+    int threads = options.threads > 0
+        ? options.threads
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<std::unique_ptr<IAgent>> agents;
+    std::vector<GameResult> results(options.games);
+    agents.reserve(options.games);
+
+    // Opening moves from a prebuilt book, shared by every agent
+    std::shared_ptr<OpeningBook> book;
+    if (!options.book.empty()) {
+        book = std::make_shared<OpeningBook>();
+        if (!book->open(options.book)) {
+            std::fprintf(stderr, "cannot open book %s\n", options.book.c_str());
+            return 1;
+        }
+    }
+
+    Scheduler scheduler;
+    GamePool pool(options.games);
+
+    for (int g = 0; g < options.games; g++) {
+        uint32_t seed = options.seed + static_cast<uint32_t>(g);
+        agents.push_back(AgentFactory::create(options.agent, seed));
+        if (agents.back() == nullptr) {
+            std::fprintf(stderr, "unknown agent: %s\n", options.agent.c_str());
+            return 1;
+        }
+        if (book != nullptr) {
+            agents.back() = std::make_unique<BookAgent>(book, std::move(agents.back()));
+        }
+        // Only the farm's own games count towards the exported engine metrics
+        Game* game = pool.acquire(seed);
+        game->setMetricsEnabled(true);
+        scheduler.spawn(playGames(scheduler, *game, *agents.back(), options, results[g]));
+    }
+
+    // Prometheus metrics while the farm runs (scrape the port or read the file)
+    MetricsExporter exporter;
+    if (options.metricsPort > 0 && !exporter.listen(options.metricsPort)) {
+        std::fprintf(stderr, "cannot listen on port %d\n", options.metricsPort);
+        return 1;
+    }
+    if (!options.metricsFile.empty()) {
+        exporter.setFile(options.metricsFile, 1.0f);
+    }
+    exporter.start();
+
+    auto started = std::chrono::steady_clock::now();
+    scheduler.run(threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    long long games = 0;
+    long long ticks = 0;
+    long long pieces = 0;
+    long long lines = 0;
+    int toppedOut = 0;
+    int minTicks = results.empty() ? 0 : results.front().ticks;
+    int maxTicks = minTicks;
+
+    for (const GameResult& result : results) {
+        games += result.games;
+        ticks += result.ticks;
+        pieces += result.piecesLocked;
+        lines += result.linesCleared;
+        toppedOut += result.toppedOut;
+        minTicks = std::min(minTicks, result.ticks);
+        maxTicks = std::max(maxTicks, result.ticks);
+    }
+
+    std::printf("%lld games (%s, %d at once) on %d threads in %.2fs\n",
+                games, options.agent.c_str(), options.games, threads, seconds);
+    std::printf("%.0f ticks/s, %.0f pieces/s, %.1f lines/game, %d topped out, ticks per slot %d..%d\n",
+                ticks / seconds, pieces / seconds,
+                static_cast<double>(lines) / games, toppedOut, minTicks, maxTicks);
+
+    return 0;
+}
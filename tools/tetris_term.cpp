@@ -0,0 +1,115 @@
+// Terminal front end (SSH, tmux, display-less servers).
+//
+// The same game as build/tetris drawn with ANSI escape codes instead of a
+// window: it links only the engine, so it builds and runs where raylib and
+// OpenGL are not available.
+//
+//   build/tools/tetris_term
+//   build/tools/tetris_term --competitive --tick-rate 240
+//   build/tools/tetris_term --broadcast /tmp/tetris.sock   # play and publish
+//   build/tools/tetris_term --watch /tmp/tetris.sock       # watch
+//   build/tools/tetris_term --record game.replay
+
+#include "engine/game.hpp"
+#include "engine/replay.hpp"
+#include "engine/simulation_loop.hpp"
+#include "net/spectator_broadcast.hpp"
+#include "net/spectator_feed.hpp"
+#include "ui/terminal_renderer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+namespace {
+    struct Options {
+        const char* broadcastPath = nullptr;
+        const char* watchPath = nullptr;
+        const char* recordPath = nullptr;
+        bool competitive = false;
+        int tickRate = SimulationLoop::DEFAULT_TICK_RATE;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            if (std::strcmp(arg, "--competitive") == 0) {
+                options.competitive = true;
+                continue;
+            }
+
+            const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+            if (value == nullptr) {
+                return false;
+            } else if (std::strcmp(arg, "--broadcast") == 0) {
+                options.broadcastPath = value;
+            } else if (std::strcmp(arg, "--watch") == 0) {
+                options.watchPath = value;
+            } else if (std::strcmp(arg, "--record") == 0) {
+                options.recordPath = value;
+            } else if (std::strcmp(arg, "--tick-rate") == 0) {
+                options.tickRate = std::max(1, std::atoi(value));
+            } else {
+                return false;
+            }
+        }
+        return options.watchPath == nullptr || options.broadcastPath == nullptr;
+    }
+
+    void printUsage() {
+        std::fprintf(stderr,
+                     "usage: tetris_term [--competitive] [--tick-rate N] [--record FILE]\n"
+                     "                   [--broadcast PATH | --watch PATH]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    Game game;
+    if (options.competitive) {
+        game.setRules(GameRules::competitive());
+    }
+    IGameEngine* engine = &game;
+
+    std::unique_ptr<SpectatorFeed> feed;
+    std::unique_ptr<SpectatorBroadcast> broadcast;
+
+    if (options.watchPath != nullptr) {
+        // Watch a game running in another process
+        feed = std::make_unique<SpectatorFeed>();
+        if (!feed->open(options.watchPath)) {
+            std::fprintf(stderr, "Cannot open spectator stream %s\n", options.watchPath);
+            return 1;
+        }
+        engine = feed.get();
+    } else if (options.broadcastPath != nullptr) {
+        broadcast = std::make_unique<SpectatorBroadcast>(game);
+        if (!broadcast->listen(options.broadcastPath)) {
+            std::fprintf(stderr, "Cannot listen on %s\n", options.broadcastPath);
+            return 1;
+        }
+        engine = broadcast.get();
+    }
+
+    std::unique_ptr<ReplayRecorder> recorder;
+    if (options.recordPath != nullptr && feed == nullptr) {
+        recorder = std::make_unique<ReplayRecorder>(*engine, game, options.tickRate);
+        engine = recorder.get();
+    }
+
+    TerminalRenderer renderer(*engine);
+    renderer.setTickRate(options.tickRate);
+    renderer.run();
+
+    if (recorder != nullptr && !recorder->getReplay().save(options.recordPath)) {
+        std::fprintf(stderr, "Cannot write replay %s\n", options.recordPath);
+        return 1;
+    }
+    return 0;
+}
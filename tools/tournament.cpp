@@ -0,0 +1,253 @@
+// Headless bot-versus-bot tournament.
+//
+// Plays every pairing of the selected agents on shared seeds, spread over
+// worker threads (each match owns its games and agents; the only shared
+// state is the match counter), then writes Elo ratings and per-match stats.
+//
+//   build/tools/tournament --agents heuristic,stacker,random --games 200
+//                          --mode versus --threads 8 --budget-us 500
+
+#include "bot/agent_factory.hpp"
+#include "bot/match.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr double ELO_START = 1500.0;
+    constexpr double ELO_K = 16.0;
+
+    struct Options {
+        std::vector<std::string> agents = AgentFactory::getNames();
+        int gamesPerPairing = 100;
+        MatchMode mode = MatchMode::DUEL;
+        int threads = 0;
+        uint32_t seed = 1;
+        int maxPieces = 1000;
+        int64_t budgetMicroseconds = 1000;
+        std::string ratingsPath = "ratings.txt";
+        std::string matchesPath = "matches.csv";
+    };
+
+    struct Scheduled {
+        int first;
+        int second;
+        uint32_t seed;
+    };
+
+    struct Standing {
+        double rating = ELO_START;
+        int wins = 0;
+        int draws = 0;
+        int losses = 0;
+        long long totalScore = 0;
+        long long totalLines = 0;
+        int games = 0;
+    };
+
+    std::vector<std::string> split(const std::string& text) {
+        std::vector<std::string> parts;
+        std::size_t start = 0;
+        while (start <= text.size()) {
+            std::size_t end = text.find(',', start);
+            if (end == std::string::npos) end = text.size();
+            if (end > start) parts.push_back(text.substr(start, end - start));
+            start = end + 1;
+        }
+        return parts;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+            if (value == nullptr) {
+                return false;
+            } else if (std::strcmp(arg, "--agents") == 0) {
+                options.agents = split(value);
+            } else if (std::strcmp(arg, "--games") == 0) {
+                options.gamesPerPairing = std::atoi(value);
+            } else if (std::strcmp(arg, "--mode") == 0) {
+                if (std::strcmp(value, "duel") == 0) options.mode = MatchMode::DUEL;
+                else if (std::strcmp(value, "versus") == 0) options.mode = MatchMode::VERSUS;
+                else return false;
+            } else if (std::strcmp(arg, "--threads") == 0) {
+                options.threads = std::atoi(value);
+            } else if (std::strcmp(arg, "--seed") == 0) {
+                options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            } else if (std::strcmp(arg, "--budget-us") == 0) {
+                options.budgetMicroseconds = std::atoll(value);
+            } else if (std::strcmp(arg, "--max-pieces") == 0) {
+                options.maxPieces = std::atoi(value);
+            } else if (std::strcmp(arg, "--ratings") == 0) {
+                options.ratingsPath = value;
+            } else if (std::strcmp(arg, "--matches") == 0) {
+                options.matchesPath = value;
+            } else {
+                return false;
+            }
+            i++;
+        }
+
+        return options.agents.size() >= 2 && options.gamesPerPairing > 0;
+    }
+
+    void printUsage() {
+        std::fprintf(stderr,
+            "usage: tournament [--agents a,b,...] [--games N] [--mode duel|versus]\n"
+            "                  [--threads N] [--seed S] [--max-pieces N] [--budget-us N]\n"
+            "                  [--ratings FILE] [--matches FILE]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    for (const std::string& name : options.agents) {
+        if (!AgentFactory::create(name, 0)) {
+            std::fprintf(stderr, "unknown agent: %s\n", name.c_str());
+            return 1;
+        }
+    }
+
+    // Every pairing plays the same list of seeds; sides alternate per game
+    std::vector<Scheduled> schedule;
+    int agentCount = static_cast<int>(options.agents.size());
+    for (int a = 0; a < agentCount; a++) {
+        for (int b = a + 1; b < agentCount; b++) {
+            for (int g = 0; g < options.gamesPerPairing; g++) {
+                uint32_t seed = options.seed + static_cast<uint32_t>(g);
+                schedule.push_back((g % 2 == 0) ? Scheduled{a, b, seed} : Scheduled{b, a, seed});
+            }
+        }
+    }
+
+    int threadCount = options.threads > 0
+        ? options.threads
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<MatchResult> results(schedule.size());
+    std::atomic<std::size_t> nextMatch(0);
+
+    auto worker = [&]() {
+        MatchConfig config;
+        config.mode = options.mode;
+        config.maxPieces = options.maxPieces;
+        config.budget.microseconds = options.budgetMicroseconds;
+
+        while (true) {
+            std::size_t index = nextMatch.fetch_add(1, std::memory_order_relaxed);
+            if (index >= schedule.size()) {
+                return;
+            }
+
+            const Scheduled& match = schedule[index];
+            config.seed = match.seed;
+
+            std::unique_ptr<IAgent> first = AgentFactory::create(options.agents[match.first], match.seed);
+            std::unique_ptr<IAgent> second = AgentFactory::create(options.agents[match.second], match.seed ^ 1u);
+            results[index] = Match::play(*first, *second, config);
+        }
+    };
+
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    // Ratings are computed in schedule order so results do not depend on threading
+    std::vector<Standing> standings(options.agents.size());
+    long long totalPieces = 0;
+
+    FILE* matchesFile = std::fopen(options.matchesPath.c_str(), "w");
+    if (matchesFile == nullptr) {
+        std::fprintf(stderr, "cannot write %s\n", options.matchesPath.c_str());
+        return 1;
+    }
+    std::fprintf(matchesFile, "match,seed,first,second,outcome,ticks,"
+                              "first_score,second_score,first_lines,second_lines,"
+                              "first_pieces,second_pieces,first_sent,second_sent,"
+                              "first_budget_used,second_budget_used,first_overruns,second_overruns\n");
+
+    for (std::size_t i = 0; i < schedule.size(); i++) {
+        const Scheduled& match = schedule[i];
+        const MatchResult& result = results[i];
+        Standing& first = standings[match.first];
+        Standing& second = standings[match.second];
+
+        double expected = 1.0 / (1.0 + std::pow(10.0, (second.rating - first.rating) / 400.0));
+        first.rating += ELO_K * (result.outcome - expected);
+        second.rating -= ELO_K * (result.outcome - expected);
+
+        if (result.outcome > 0.5) { first.wins++; second.losses++; }
+        else if (result.outcome < 0.5) { first.losses++; second.wins++; }
+        else { first.draws++; second.draws++; }
+
+        Standing* sides[2] = {&first, &second};
+        for (int p = 0; p < 2; p++) {
+            sides[p]->games++;
+            sides[p]->totalScore += result.players[p].score;
+            sides[p]->totalLines += result.players[p].linesCleared;
+            totalPieces += result.players[p].piecesLocked;
+        }
+
+        std::fprintf(matchesFile, "%zu,%u,%s,%s,%.1f,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.3f,%.3f,%d,%d\n",
+                     i, match.seed, options.agents[match.first].c_str(),
+                     options.agents[match.second].c_str(), result.outcome, result.ticks,
+                     result.players[0].score, result.players[1].score,
+                     result.players[0].linesCleared, result.players[1].linesCleared,
+                     result.players[0].piecesLocked, result.players[1].piecesLocked,
+                     result.players[0].garbageSent, result.players[1].garbageSent,
+                     result.players[0].budgetUsed, result.players[1].budgetUsed,
+                     result.players[0].overruns, result.players[1].overruns);
+    }
+    std::fclose(matchesFile);
+
+    std::vector<int> order(options.agents.size());
+    for (int i = 0; i < agentCount; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return standings[a].rating > standings[b].rating;
+    });
+
+    FILE* ratingsFile = std::fopen(options.ratingsPath.c_str(), "w");
+    if (ratingsFile == nullptr) {
+        std::fprintf(stderr, "cannot write %s\n", options.ratingsPath.c_str());
+        return 1;
+    }
+    std::fprintf(ratingsFile, "# rank agent elo games wins draws losses avg_score avg_lines\n");
+    for (int rank = 0; rank < agentCount; rank++) {
+        const Standing& standing = standings[order[rank]];
+        int games = std::max(1, standing.games);
+        std::fprintf(ratingsFile, "%d %s %.1f %d %d %d %d %.1f %.1f\n",
+                     rank + 1, options.agents[order[rank]].c_str(), standing.rating,
+                     standing.games, standing.wins, standing.draws, standing.losses,
+                     static_cast<double>(standing.totalScore) / games,
+                     static_cast<double>(standing.totalLines) / games);
+    }
+    std::fclose(ratingsFile);
+
+    std::printf("%zu matches on %d threads in %.2fs (%.1f matches/s, %.0f pieces/s)\n",
+                schedule.size(), threadCount, seconds,
+                schedule.size() / seconds, totalPieces / seconds);
+
+    return 0;
+}